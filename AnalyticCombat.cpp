@@ -0,0 +1,202 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Exact evaluator for a single attacker/weapon/defender matchup. Instead
+of rolling dice, follows the probability of every possible number of
+hits, wounds and failed saves through the same thresholds that
+Character::combat uses, and returns the resulting DamageDistribution. */
+
+#include "AnalyticCombat.h"
+#include "CombatRules.h"
+#include "Fft.h"
+#include <vector>
+#include <complex>
+#include <stdexcept>
+
+using namespace std;
+
+/** Applies one stage of rolls to a distribution of dice counts. Each
+die passes independently with the given chance, so each count n is
+spread over 0..n as a binomial distribution.
+
+"counts" holds the probability of rolling each number of dice.
+"chance" is the probability a single die passes.
+
+Precondition: chance must be between 0 and 1.
+Postcondition: Returns the probability of each number of passing
+dice. */
+vector<double> AnalyticCombat::thin(const vector<double>& counts, double chance)
+{
+   vector<double> result(counts.size(), 0.0);
+
+   //Row n of the binomial table, built up one die at a time so it
+   //never underflows the way q^n does for large pools.
+   vector<double> row(1, 1.0);
+   row.reserve(counts.size());
+
+   for (int n = 0; unsigned(n) < counts.size(); n++) {
+      if (n > 0) {
+         row.push_back(0.0);
+         for (int k = n; k > 0; k--) {
+            row[k] = row[k] * (1 - chance) + row[k - 1] * chance;
+         }
+         row[0] *= (1 - chance);
+      }
+
+      if (counts[n] == 0) continue;
+      for (int k = 0; k <= n; k++) {
+         result[k] += counts[n] * row[k];
+      }
+   }
+
+   return result;
+}
+
+/** Returns the probability of each number of unsaved wounds, before
+damage is applied.
+
+"profile" is the matchup to evaluate.
+
+Precondition: None.
+Postcondition: Returns a vector indexed by number of failed saves. */
+vector<double> AnalyticCombat::failedSaveDistribution(const CombatProfile& profile)
+{
+   int attacks = (profile.attacks > 0) ? profile.attacks : 0;
+   int toWound = woundRoll(profile.strength, profile.toughness);
+   int saveRoll = bestSave(profile.armorSave, profile.invulnSave, profile.ap);
+
+   vector<double> dice(attacks + 1, 0.0);
+   dice[attacks] = 1.0;
+
+   vector<double> hits = thin(dice, chanceAtLeast(profile.hitStat));
+   vector<double> wounds = thin(hits, chanceAtLeast(toWound));
+   return thin(wounds, 1 - chanceAtLeast(saveRoll));
+}
+
+/** Turns a distribution of unsaved wounds into one of damage, each
+wound doing the given damage.
+
+"failedSaves" is indexed by number of unsaved wounds.
+"damage" is the damage of each wound.
+
+Precondition: The largest damage must fit in MAX_ANALYTIC_DAMAGE.
+Postcondition: Returns a DamageDistribution. */
+DamageDistribution AnalyticCombat::applyDamage(const vector<double>& failedSaves, int damage)
+{
+   vector<double> pmf((size_t)(failedSaves.size() - 1) * damage + 1, 0.0);
+   for (size_t i = 0; i < failedSaves.size(); i++) {
+      pmf[i * damage] += failedSaves[i];
+   }
+
+   return DamageDistribution(pmf);
+}
+
+/** Returns whether the largest damage a profile can do is small
+enough for its distribution to be held, i.e. at most
+MAX_ANALYTIC_DAMAGE. Every attack counts as at least 1 damage, since
+the unsaved wounds are worked out one per attack before damage is
+applied. At the limit a distribution takes 8 MB.
+
+"profile" is the matchup.
+
+Precondition: None.
+Postcondition: Returns a bool. */
+bool AnalyticCombat::canEvaluate(const CombatProfile& profile)
+{
+   long long attacks = (profile.attacks > 0) ? profile.attacks : 0;
+   long long damage = (profile.damage > 1) ? profile.damage : 1;
+   return attacks * damage <= MAX_ANALYTIC_DAMAGE;
+}
+
+/** Returns the distribution of damage dealt.
+
+"profile" is the matchup to evaluate.
+"allowApproximate" is whether pools of PGF_MIN_ATTACKS attacks or
+more may go through evaluateByPgf, trading exactness for speed.
+
+Precondition: canEvaluate(profile) must be true.
+Postcondition: Returns a DamageDistribution. It is exact unless
+allowApproximate is true and the pool is large enough for the PGF.
+Throws length_error if the largest damage is too large to hold. */
+DamageDistribution AnalyticCombat::evaluate(const CombatProfile& profile,
+   bool allowApproximate)
+{
+   if (!canEvaluate(profile)) throw length_error("Damage too large to evaluate");
+   if (allowApproximate && profile.attacks >= PGF_MIN_ATTACKS) {
+      return evaluateByPgf(profile);
+   }
+
+   int damage = (profile.damage > 0) ? profile.damage : 0;
+   return applyDamage(failedSaveDistribution(profile), damage);
+}
+
+/** Returns an approximation of the distribution of damage dealt,
+worked out through probability generating functions. A stage where
+each die passes with chance c maps a PGF G(z) to G(1 - c + cz).
+Composing the attacks' PGF z^A through the three stages gives the
+PGF of the number of unsaved wounds, which is evaluated at the roots
+of unity and turned back into probabilities by an inverse FFT. Each
+wound then does D damage.
+
+"profile" is the matchup to evaluate.
+
+Precondition: canEvaluate(profile) must be true.
+Postcondition: Returns a DamageDistribution. Costs O(A log A) in the
+number of attacks A, but each probability carries an absolute
+rounding error of up to around 1e-15. Chances under PGF_NOISE_FLOOR
+read as 0, and the total is off from 1 by the sum of the errors. Not
+suitable for rare-kill probabilities. Throws length_error if the
+largest damage is too large to hold. */
+DamageDistribution AnalyticCombat::evaluateByPgf(const CombatProfile& profile)
+{
+   if (!canEvaluate(profile)) throw length_error("Damage too large to evaluate");
+
+   int attacks = (profile.attacks > 0) ? profile.attacks : 0;
+   int damage = (profile.damage > 0) ? profile.damage : 0;
+   double hit = chanceAtLeast(profile.hitStat);
+   double wound = chanceAtLeast(woundRoll(profile.strength, profile.toughness));
+   double fail = 1 - chanceAtLeast(bestSave(profile.armorSave, profile.invulnSave,
+      profile.ap));
+
+   //Transform over unsaved wounds rather than damage, so damage that
+   //isn't a multiple of D can't pick up rounding noise.
+   int n = Fft::paddedSize(attacks + 1);
+   vector<complex<double>> values(n);
+
+   for (int k = 0; k < n; k++) {
+      //Work from the inside out: each stage, then the pool.
+      complex<double> z = polar(1.0, -2 * PI * k / n);
+      complex<double> perHit = (1 - wound) + wound * ((1 - fail) + fail * z);
+      complex<double> perAttack = (1 - hit) + hit * perHit;
+      values[k] = pow(perAttack, attacks);
+   }
+
+   Fft::transform(values, true);
+
+   //The forward transform's sign convention means evaluating at
+   //e^(-2 pi i k / n) and inverting recovers the coefficients directly.
+   //Anything under PGF_NOISE_FLOOR is rounding noise and is dropped, so
+   //tails too rare to resolve sum to 0 rather than to noise.
+   vector<double> failedSaves(attacks + 1, 0.0);
+   for (int i = 0; i <= attacks; i++) {
+      double value = values[i].real();
+      failedSaves[i] = (value > PGF_NOISE_FLOOR) ? value : 0;
+   }
+
+   return applyDamage(failedSaves, damage);
+}
+
+/** Returns the distribution of the total damage of two independent
+attacks, such as two weapons fired in the same volley, by FFT
+convolution.
+
+"first" and "second" are the damage of each attack.
+
+Precondition: None.
+Postcondition: Returns a DamageDistribution. */
+DamageDistribution AnalyticCombat::combine(const DamageDistribution& first,
+   const DamageDistribution& second)
+{
+   return DamageDistribution(Fft::convolve(first.probabilities(), second.probabilities()));
+}
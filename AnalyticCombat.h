@@ -0,0 +1,117 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Exact evaluator for a single attacker/weapon/defender matchup. Instead
+of rolling dice, follows the probability of every possible number of
+hits, wounds and failed saves through the same thresholds that
+Character::combat uses, and returns the resulting DamageDistribution.
+Costs O(attacks^2) and gives the Monte Carlo engine a ground truth to
+be checked against.
+
+Callers that can accept a rounding error of up to around 1e-15 in every
+probability may ask for pools of PGF_MIN_ATTACKS attacks or more to be
+evaluated through their probability generating function in O(n log n)
+instead, so horde-sized volleys stay interactive. */
+
+#include "CombatProfile.h"
+#include "DamageDistribution.h"
+#include <vector>
+
+using namespace std;
+
+const int PGF_MIN_ATTACKS = 128;      //Attacks at which evaluate() may use the PGF
+const double PGF_NOISE_FLOOR = 1e-15; //Smallest probability the PGF path resolves
+const long long MAX_ANALYTIC_DAMAGE = 1LL << 20; //Largest damage either path can hold
+
+class AnalyticCombat
+{
+private:
+   /** Applies one stage of rolls to a distribution of dice counts. Each
+   die passes independently with the given chance, so each count n is
+   spread over 0..n as a binomial distribution.
+
+   "counts" holds the probability of rolling each number of dice.
+   "chance" is the probability a single die passes.
+
+   Precondition: chance must be between 0 and 1.
+   Postcondition: Returns the probability of each number of passing
+   dice. */
+   static vector<double> thin(const vector<double>& counts, double chance);
+
+   /** Turns a distribution of unsaved wounds into one of damage, each
+   wound doing the given damage.
+
+   "failedSaves" is indexed by number of unsaved wounds.
+   "damage" is the damage of each wound.
+
+   Precondition: The largest damage must fit in MAX_ANALYTIC_DAMAGE.
+   Postcondition: Returns a DamageDistribution. */
+   static DamageDistribution applyDamage(const vector<double>& failedSaves, int damage);
+
+public:
+   /** Returns whether the largest damage a profile can do is small
+   enough for its distribution to be held, i.e. at most
+   MAX_ANALYTIC_DAMAGE. Every attack counts as at least 1 damage, since
+   the unsaved wounds are worked out one per attack before damage is
+   applied. At the limit a distribution takes 8 MB.
+
+   "profile" is the matchup.
+
+   Precondition: None.
+   Postcondition: Returns a bool. */
+   static bool canEvaluate(const CombatProfile& profile);
+
+   /** Returns the probability of each number of unsaved wounds, before
+   damage is applied.
+
+   "profile" is the matchup to evaluate.
+
+   Precondition: None.
+   Postcondition: Returns a vector indexed by number of failed saves. */
+   static vector<double> failedSaveDistribution(const CombatProfile& profile);
+
+   /** Returns the distribution of damage dealt.
+
+   "profile" is the matchup to evaluate.
+   "allowApproximate" is whether pools of PGF_MIN_ATTACKS attacks or
+   more may go through evaluateByPgf, trading exactness for speed.
+
+   Precondition: canEvaluate(profile) must be true.
+   Postcondition: Returns a DamageDistribution. It is exact unless
+   allowApproximate is true and the pool is large enough for the PGF.
+   Throws length_error if the largest damage is too large to hold. */
+   static DamageDistribution evaluate(const CombatProfile& profile,
+      bool allowApproximate = false);
+
+   /** Returns an approximation of the distribution of damage dealt,
+   worked out through probability generating functions. A stage where
+   each die passes with chance c maps a PGF G(z) to G(1 - c + cz).
+   Composing the attacks' PGF z^A through the three stages gives the
+   PGF of the number of unsaved wounds, which is evaluated at the roots
+   of unity and turned back into probabilities by an inverse FFT. Each
+   wound then does D damage.
+
+   "profile" is the matchup to evaluate.
+
+   Precondition: canEvaluate(profile) must be true.
+   Postcondition: Returns a DamageDistribution. Costs O(A log A) in the
+   number of attacks A, but each probability carries an absolute
+   rounding error of up to around 1e-15. Chances under PGF_NOISE_FLOOR
+   read as 0, and the total is off from 1 by the sum of the errors. Not
+   suitable for rare-kill probabilities. Throws length_error if the
+   largest damage is too large to hold. */
+   static DamageDistribution evaluateByPgf(const CombatProfile& profile);
+
+   /** Returns the distribution of the total damage of two independent
+   attacks, such as two weapons fired in the same volley, by FFT
+   convolution.
+
+   "first" and "second" are the damage of each attack.
+
+   Precondition: None.
+   Postcondition: Returns a DamageDistribution. */
+   static DamageDistribution combine(const DamageDistribution& first,
+      const DamageDistribution& second);
+};
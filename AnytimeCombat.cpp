@@ -0,0 +1,171 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Answers a matchup query within a wall-clock budget, exactly if the
+analytic path fits and by Monte Carlo with an error bar otherwise. */
+
+#include "AnytimeCombat.h"
+#include "AnalyticCombat.h"
+#include "MonteCarlo.h"
+#include "DamageHistogram.h"
+#include <chrono>
+#include <cmath>
+
+using namespace std;
+
+//Time per step at CALIBRATION_SMALL and CALIBRATION_LARGE attacks on a
+//typical desktop, used until calibrate() measures this machine.
+const double DEFAULT_SMALL_NANOS = 1.6;
+const double DEFAULT_LARGE_NANOS = 3.0;
+
+AnytimeCombat::Calibration AnytimeCombat::calibration_ = { DEFAULT_SMALL_NANOS,
+   DEFAULT_LARGE_NANOS };
+
+/** Returns the number of steps the exact path takes for a profile.
+Each of the three stages of AnalyticCombat costs about attacks^2 / 2
+steps, and each entry of the damage distribution, of which there are
+attacks * damage, costs STEPS_PER_ENTRY more to allocate, fill and
+summarise.
+
+"attacks" is the number of attacks.
+"damage" is the damage of each wound.
+
+Precondition: None.
+Postcondition: Returns the steps as a double. */
+double AnytimeCombat::analyticSteps(int attacks, int damage)
+{
+   double n = (attacks > 0) ? attacks + 1.0 : 1.0;
+   double entries = (n - 1) * ((damage > 0) ? damage : 0) + 1;
+   return 3 * n * n / 2 + STEPS_PER_ENTRY * entries;
+}
+
+/** Times AnalyticCombat::evaluate on a pool of the given size.
+
+"attacks" is the size of the pool.
+
+Precondition: None.
+Postcondition: Returns the fastest of CALIBRATION_RUNS timings, per
+step, in nanoseconds. */
+double AnytimeCombat::timeSteps(int attacks)
+{
+   CombatProfile profile = { 3, attacks, 4, 1, 1, 4, 3, 0, 1 };
+
+   long long fastest = -1;
+   for (int i = 0; i < CALIBRATION_RUNS; i++) {
+      auto start = chrono::steady_clock::now();
+      DamageDistribution distribution = AnalyticCombat::evaluate(profile);
+      long long taken = chrono::duration_cast<chrono::nanoseconds>(
+         chrono::steady_clock::now() - start).count();
+      if (distribution.mean() < 0) taken++; //Keeps the work from being optimised out
+      if (fastest < 0 || taken < fastest) fastest = taken;
+   }
+
+   return (double)(fastest > 0 ? fastest : 1) / analyticSteps(attacks, profile.damage);
+}
+
+/** Replaces the default cost model with timings taken on this
+machine. Meant to be called once at startup, since it takes around
+20 milliseconds.
+
+Precondition: No other thread may be using AnytimeCombat.
+Postcondition: analyticCost() predicts from the new timings. */
+void AnytimeCombat::calibrate()
+{
+   calibration_.smallNanos = timeSteps(CALIBRATION_SMALL);
+   calibration_.largeNanos = timeSteps(CALIBRATION_LARGE);
+}
+
+/** Predicts how long the exact evaluation of a profile takes, from
+the number of steps it needs and the time per step. A step gets
+slower as the pool's arrays spill out of cache, so the time per step
+is known at CALIBRATION_SMALL and CALIBRATION_LARGE attacks, either
+from the default model or from calibrate(). For other sizes, it is
+taken to grow by the same amount for every doubling of the pool, and
+never to drop below the small pool's.
+
+"profile" is the matchup.
+
+Precondition: None.
+Postcondition: Returns nanoseconds as a long long. */
+long long AnytimeCombat::analyticCost(const CombatProfile& profile)
+{
+   const Calibration& measured = calibration_;
+   double perDoubling = (measured.largeNanos - measured.smallNanos)
+      / log2((double)CALIBRATION_LARGE / CALIBRATION_SMALL);
+   if (perDoubling < 0) perDoubling = 0;
+
+   double doublings = (profile.attacks > CALIBRATION_SMALL)
+      ? log2((double)profile.attacks / CALIBRATION_SMALL) : 0;
+   double nanosPerStep = measured.smallNanos + perDoubling * doublings;
+
+   return (long long)(analyticSteps(profile.attacks, profile.damage) * nanosPerStep);
+}
+
+/** Returns the best estimate of a matchup that can be made within the
+budget.
+
+"profile" is the matchup.
+"budget" is the time allowed, e.g. chrono::milliseconds(5).
+"seed" seeds the Monte Carlo trials.
+"z" is the z-score of the confidence level, e.g. 1.96 for 95%.
+
+Precondition: None.
+Postcondition: Returns an AnytimeEstimate. At least one batch of
+trials is run even if the budget is too small for it, so the call
+may overrun a tiny budget. The number of trials depends on the
+speed of the machine, but trial i always gets the same rolls for a
+given seed. */
+AnytimeEstimate AnytimeCombat::estimate(const CombatProfile& profile,
+   chrono::nanoseconds budget, uint64_t seed, double z)
+{
+   auto start = chrono::steady_clock::now();
+   auto deadline = start + budget;
+   AnytimeEstimate result;
+
+   //Leave half the budget spare, since the cost is only a prediction.
+   if (AnalyticCombat::canEvaluate(profile) && analyticCost(profile) <= budget.count() / 2) {
+      DamageDistribution distribution = AnalyticCombat::evaluate(profile);
+      result.mean = result.meanLower = result.meanUpper = distribution.mean();
+      result.killProbability = result.killLower = result.killUpper =
+         distribution.killProbability(profile.defenderWounds);
+      result.exact = true;
+      result.trials = 0;
+   }
+   else {
+      MonteCarlo engine(seed);
+      engine.setSamplingMode(BINOMIAL);
+      DamageHistogram histogram;
+
+      //Stop once another batch, going by how long the last one took,
+      //would run past the deadline.
+      auto now = chrono::steady_clock::now();
+      auto batchTime = now - now;
+      do {
+         engine.simulate(profile, histogram.trials(), BATCH_SIZE, histogram);
+         auto finished = chrono::steady_clock::now();
+         batchTime = finished - now;
+         now = finished;
+      } while (now + batchTime <= deadline);
+
+      //Every trial doing the same damage says little about outcomes too
+      //rare to have turned up yet. Fall back on the rule of three, as
+      //ParallelMonteCarlo::runToPrecision does.
+      double halfWidth = histogram.meanHalfWidth(z);
+      if (histogram.variance() == 0) {
+         double maxDamage = (double)profile.attacks * profile.damage;
+         halfWidth = maxDamage * 3 / histogram.trials() / 2;
+      }
+      result.mean = histogram.mean();
+      result.meanLower = result.mean - halfWidth;
+      result.meanUpper = result.mean + halfWidth;
+      result.killProbability = histogram.killProbability(profile.defenderWounds);
+      histogram.killInterval(profile.defenderWounds, z, result.killLower, result.killUpper);
+      result.exact = false;
+      result.trials = histogram.trials();
+   }
+
+   result.elapsedNanos = chrono::duration_cast<chrono::nanoseconds>(
+      chrono::steady_clock::now() - start).count();
+   return result;
+}
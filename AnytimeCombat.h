@@ -0,0 +1,114 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Answers a matchup query within a wall-clock budget rather than a trial
+count, for callers that need predictable latency. If AnalyticCombat's
+exact answer is predicted to fit in the budget it is used, and the error
+bar is zero. Otherwise Monte Carlo trials are run in small batches, in
+BINOMIAL mode so a batch costs the same however many dice are rolled,
+until the budget runs out, and the estimate comes with a confidence
+interval. */
+
+#include "CombatProfile.h"
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+/** Best estimate reached within the budget. For an exact answer the
+bounds equal the estimates and trials is 0. */
+struct AnytimeEstimate
+{
+   double mean;            //Expected damage
+   double meanLower;       //Confidence interval on the expected damage
+   double meanUpper;
+   double killProbability; //Chance of killing the defender
+   double killLower;       //Confidence interval on the kill probability
+   double killUpper;
+   bool exact;             //Whether the analytic path was used
+   long long trials;       //Monte Carlo trials run
+   long long elapsedNanos; //Time actually taken
+};
+
+class AnytimeCombat
+{
+private:
+   static const long long BATCH_SIZE = 256;    //Trials between clock checks
+   static const int CALIBRATION_SMALL = 256;   //Pool that fits in cache
+   static const int CALIBRATION_LARGE = 1024;  //Pool that no longer does
+   static const int CALIBRATION_RUNS = 3;      //Timings taken of each, keeping the fastest
+   static const int STEPS_PER_ENTRY = 4;       //Cost of one damage entry, in steps
+
+   /** Time per step at the two calibration pools. */
+   struct Calibration
+   {
+      double smallNanos;
+      double largeNanos;
+   };
+
+   static Calibration calibration_; //Starts off at the default model
+
+   /** Returns the number of steps the exact path takes for a profile.
+   Each of the three stages of AnalyticCombat costs about attacks^2 / 2
+   steps, and each entry of the damage distribution, of which there are
+   attacks * damage, costs STEPS_PER_ENTRY more to allocate, fill and
+   summarise.
+
+   "attacks" is the number of attacks.
+   "damage" is the damage of each wound.
+
+   Precondition: None.
+   Postcondition: Returns the steps as a double. */
+   static double analyticSteps(int attacks, int damage);
+
+   /** Times AnalyticCombat::evaluate on a pool of the given size.
+
+   "attacks" is the size of the pool.
+
+   Precondition: None.
+   Postcondition: Returns the fastest of CALIBRATION_RUNS timings, per
+   step, in nanoseconds. */
+   static double timeSteps(int attacks);
+
+public:
+   /** Replaces the default cost model with timings taken on this
+   machine. Meant to be called once at startup, since it takes around
+   20 milliseconds.
+
+   Precondition: No other thread may be using AnytimeCombat.
+   Postcondition: analyticCost() predicts from the new timings. */
+   static void calibrate();
+
+   /** Predicts how long the exact evaluation of a profile takes, from
+   the number of steps it needs and the time per step. A step gets
+   slower as the pool's arrays spill out of cache, so the time per step
+   is known at CALIBRATION_SMALL and CALIBRATION_LARGE attacks, either
+   from the default model or from calibrate(). For other sizes, it is
+   taken to grow by the same amount for every doubling of the pool, and
+   never to drop below the small pool's.
+
+   "profile" is the matchup.
+
+   Precondition: None.
+   Postcondition: Returns nanoseconds as a long long. */
+   static long long analyticCost(const CombatProfile& profile);
+
+   /** Returns the best estimate of a matchup that can be made within the
+   budget.
+
+   "profile" is the matchup.
+   "budget" is the time allowed, e.g. chrono::milliseconds(5).
+   "seed" seeds the Monte Carlo trials.
+   "z" is the z-score of the confidence level, e.g. 1.96 for 95%.
+
+   Precondition: None.
+   Postcondition: Returns an AnytimeEstimate. At least one batch of
+   trials is run even if the budget is too small for it, so the call
+   may overrun a tiny budget. The number of trials depends on the
+   speed of the machine, but trial i always gets the same rolls for a
+   given seed. */
+   static AnytimeEstimate estimate(const CombatProfile& profile, chrono::nanoseconds budget,
+      uint64_t seed, double z = 1.96);
+};
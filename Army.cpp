@@ -114,9 +114,10 @@ Army::Army(string fileName)
             }
          }
 
-         //Reach end of given Character, add to Army.
+         //Reach end of given Character, add to Army. A repeated name
+         //is dropped, as the tree always did.
 
-         add(newChar);
+         if (!add(newChar)) delete newChar;
       }
    }
    else {
@@ -201,10 +202,18 @@ void Army::toString() const
 Precondition: Character should be initialized
 fully so it is ready to participate in "battle".
 Postcondition: Adds the Character pointer to the
-Army. Takes responsibility for the Character's data. */
+Army and returns true. Takes responsibility for the Character's
+data. If a Character with exactly the same name is already in the
+Army, returns false and leaves both as they were, so the caller
+keeps the Character. */
 bool Army::add(Character* newChar)
 {
+   //The tree would drop a second Character with the same name, so turn
+   //it away before any of the indexes take it.
+   string name = newChar->getName();
+   if (!nameIndex.add(name, newChar)) return false;
    root = insert(root, newChar);
+   nameTrie.add(name, newChar);
 
    size++;
    return true;
@@ -306,36 +315,59 @@ to garbage. Outputs an error message to cout if the Character
 is not found. */
 Character* Army::retrieve(string name) const
 {
-   Character* ptr = searchByName(name, root);
+   Character* ptr = searchByName(name);
    if (ptr == nullptr) {
       cout << endl << name << " was not found." << endl;
    }
    return ptr;
 }
 
-/** Locates a Character pointer with a string key, starting at the given root
-of a subtree.
+/** Lists the Characters whose names start with the given text.
+NOT case sensitive.
 
-"key" is a string with the exact name of the character.
-"root" is a Node pointer, the root of a subtree.
+"prefix" is the start of a name.
+"limit" is the most Characters to return.
 
 Precondition: None.
-Postcondition: Returns a pointer to the Character object in question. If the object
-is not found, returns nullptr. */
-Character* Army::searchByName(string name, Node* node) const
+Postcondition: Returns at most limit Character pointers in
+alphabetical order. */
+vector<Character*> Army::complete(string_view prefix, int limit) const
 {
-   if (node == nullptr) return nullptr;
+   return nameTrie.complete(prefix, limit);
+}
 
-   if (name == node->character->getName()) {
-      return node->character;
-   }
+/** Lists the Characters whose names are close to the given name,
+i.e. within maxDistance single letter insertions, deletions or
+substitutions. NOT case sensitive.
 
-   if (name < node->character->getName()) {
-      return searchByName(name, node->left);
-   }
-   else {
-      return searchByName(name, node->right);
+"name" is the name as typed.
+"maxDistance" is the most edits allowed.
+"limit" is the most Characters to return.
+
+Precondition: maxDistance must not be negative.
+Postcondition: Returns at most limit Character pointers, closest
+first. */
+vector<Character*> Army::suggest(string_view name, int maxDistance, int limit) const
+{
+   return nameTrie.suggest(name, maxDistance, limit);
+}
+
+/** Locates a Character pointer with a string key through the name
+hash index. An exact match is preferred; failing that, a name that
+differs only in case or surrounding whitespace is accepted.
+
+"name" is the name of the character.
+
+Precondition: None.
+Postcondition: Returns a pointer to the Character object in question. If the object
+is not found, returns nullptr. */
+Character* Army::searchByName(string_view name) const
+{
+   Character* ptr = nameIndex.find(name, false);
+   if (ptr == nullptr) {
+      ptr = nameIndex.find(name, true);
    }
+   return ptr;
 }
 
 /** Rotates the unbalanced node with its left child.
@@ -404,6 +436,38 @@ int Army::numCharacters() const
    return size;
 }
 
+/** Returns every Character in the Army, sorted by name.
+
+Precondition: None.
+Postcondition: Returns a vector of Character pointers. The Army still
+owns the Characters. */
+vector<Character*> Army::getCharacters() const
+{
+   vector<Character*> result;
+   result.reserve(size);
+   collect(root, result);
+   return result;
+}
+
+/** Private recursive helper that appends every Character in the
+subtree to a vector using inorder traversal.
+
+"node" is the root of a subtree.
+"result" is the vector being filled.
+
+Precondition: None.
+Postcondition: result holds the subtree's Characters sorted by name. */
+void Army::collect(Node* node, vector<Character*>& result) const
+{
+   if (node == nullptr) {
+      return;
+   }
+
+   collect(node->left, result);
+   result.push_back(node->character);
+   collect(node->right, result);
+}
+
 /** Overloaded output operator. Details all of the characters
 in the army, including all their names, statistics, weapons,
 and psychic abilities.
@@ -12,7 +12,10 @@ https://www.geeksforgeeks.org/avl-tree-set-1-insertion/
 with slight modifications. */
 
 #include "Character.h"
+#include "NameHashIndex.h"
+#include "NameTrie.h"
 #include <fstream>
+#include <string_view>
 
 class Army
 {
@@ -81,20 +84,39 @@ private:
    Postcondition: Sends all strings to outstream. */
    friend void sendSubTreeToOut(ostream& os, const Army& army, Army::Node* node);
 
-   /** Locates a Character pointer with a string key, starting at the given root
-   of a subtree. 
-   
-   "key" is a string with the exact name of the character.
-   "root" is a Node pointer, the root of a subtree. 
-   
+   /** Locates a Character pointer with a string key through the name
+   hash index. An exact match is preferred; failing that, a name that
+   differs only in case or surrounding whitespace is accepted.
+
+   "name" is the name of the character.
+
    Precondition: None.
    Postcondition: Returns a pointer to the Character object in question. If the object
    is not found, returns nullptr. */
-   Character* searchByName(string name, Node* node) const;
+   Character* searchByName(string_view name) const;
+
+   /** Private recursive helper that appends every Character in the
+   subtree to a vector using inorder traversal.
+
+   "node" is the root of a subtree.
+   "result" is the vector being filled.
+
+   Precondition: None.
+   Postcondition: result holds the subtree's Characters sorted by name. */
+   void collect(Node* node, vector<Character*>& result) const;
 
    Node* root;
    int size;
 
+   //Hash index from name to Character, kept up to date by add(), so a
+   //lookup by name costs O(1) whatever the size of the tree.
+   NameHashIndex nameIndex;
+
+   //Trie over the same names, kept up to date by add() as well, for
+   //completing a partly typed name and suggesting names close to one
+   //that was mistyped.
+   NameTrie nameTrie;
+
 
 public:
 
@@ -175,7 +197,10 @@ public:
    Precondition: Character should be initialized
    fully so it is ready to participate in "battle".
    Postcondition: Adds the Character pointer to the
-   Army. Takes responsibility for the Character's data. */
+   Army and returns true. Takes responsibility for the Character's
+   data. If a Character with exactly the same name is already in the
+   Army, returns false and leaves both as they were, so the caller
+   keeps the Character. */
    bool add(Character* newChar);
 
    /** Searches for a certain character by its name and returns
@@ -189,6 +214,30 @@ public:
    to garbage. */
    Character* retrieve(string name) const; //Get Character ptr by name
 
+   /** Lists the Characters whose names start with the given text.
+   NOT case sensitive.
+
+   "prefix" is the start of a name.
+   "limit" is the most Characters to return.
+
+   Precondition: None.
+   Postcondition: Returns at most limit Character pointers in
+   alphabetical order. */
+   vector<Character*> complete(string_view prefix, int limit) const;
+
+   /** Lists the Characters whose names are close to the given name,
+   i.e. within maxDistance single letter insertions, deletions or
+   substitutions. NOT case sensitive.
+
+   "name" is the name as typed.
+   "maxDistance" is the most edits allowed.
+   "limit" is the most Characters to return.
+
+   Precondition: maxDistance must not be negative.
+   Postcondition: Returns at most limit Character pointers, closest
+   first. */
+   vector<Character*> suggest(string_view name, int maxDistance, int limit) const;
+
    /** Rotates the unbalanced node with its left child.
 
    "node" is the unbalanced node passed by reference.
@@ -219,6 +268,13 @@ public:
    Postcondition: Returns the number of Characters as an int. */
    int numCharacters() const; //Return size
 
+   /** Returns every Character in the Army, sorted by name.
+
+   Precondition: None.
+   Postcondition: Returns a vector of Character pointers. The Army still
+   owns the Characters. */
+   vector<Character*> getCharacters() const;
+
    /** Overloaded output operator. Details all of the characters
    in the army, including all their names, statistics, weapons,
    and psychic abilities.
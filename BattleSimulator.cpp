@@ -0,0 +1,220 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Plays whole battles between two Armies, tracking each unit's wounds
+per battle, and reports win rates, survivors and attrition curves over
+many battles run in parallel. */
+
+#include "BattleSimulator.h"
+#include "MonteCarlo.h"
+#include <vector>
+#include <memory>
+#include <random>
+
+using namespace std;
+
+//Running totals for the battles played by one worker, padded so two
+//workers never share a cache line.
+struct alignas(64) BattleSimulator::Tally
+{
+   long long battles = 0;
+   long long wins[2] = { 0, 0 };
+   long long draws = 0;
+   long long survivors[2] = { 0, 0 };
+   vector<long long> alive[2];
+};
+
+/** Constructor that copies both armies into CharacterTables and starts
+the worker threads.
+
+"first" and "second" are the two Armies. They may be the same Army.
+"numThreads" is the number of workers. If 0, one is started per
+hardware thread.
+
+Precondition: None.
+Postcondition: Creates a BattleSimulator. */
+BattleSimulator::BattleSimulator(const Army& first, const Army& second, int numThreads)
+   : sides_{ CharacterTable(first), CharacterTable(second) }, pool_(numThreads),
+   mode_(BINOMIAL)
+{
+}
+
+/** Chooses how attacks are resolved. Defaults to BINOMIAL, since no
+individual dice are ever shown.
+
+"mode" is a SamplingMode.
+
+Precondition: None.
+Postcondition: Later runs use the given mode. */
+void BattleSimulator::setSamplingMode(SamplingMode mode)
+{
+   mode_ = mode;
+}
+
+/** One side attacks with every living unit.
+
+"attackers" is the acting side's index.
+"wounds" holds the remaining wounds of every unit on both sides.
+"alive" holds the indices of the living units on both sides.
+"generator" is the battle's generator.
+"dice" is reused storage for the rolls.
+
+Precondition: None.
+Postcondition: Damage is applied to the other side, and units reduced
+to 0 wounds are removed from alive. */
+void BattleSimulator::takeTurn(int attackers, vector<int> wounds[2], vector<int> alive[2],
+   CounterRng& generator, vector<uint8_t>& dice) const
+{
+   int defenders = 1 - attackers;
+   const CharacterTable& table = sides_[attackers];
+   const CharacterTable& enemies = sides_[defenders];
+
+   //Copy, since units killed by this side can't be attacking anyway.
+   vector<int> acting = alive[attackers];
+
+   for (int unit : acting) {
+      if (alive[defenders].empty()) return;
+
+      uniform_int_distribution<int> pick(0, (int)alive[defenders].size() - 1);
+      int slot = pick(generator);
+      int target = alive[defenders][slot];
+
+      //Ranged weapons come first in the table, so this is shooting and
+      //then melee.
+      for (int weapon = table.weaponBegin(unit); weapon < table.weaponEnd(unit); weapon++) {
+         CombatProfile profile = table.profile(unit, weapon, enemies, target,
+            wounds[defenders][target]);
+
+         int toWound = woundRoll(profile.strength, profile.toughness);
+         int saveRoll = bestSave(profile.armorSave, profile.invulnSave, profile.ap);
+         wounds[defenders][target] -= MonteCarlo::rollAttack(profile, toWound, saveRoll,
+            generator, mode_, dice);
+
+         if (wounds[defenders][target] <= 0) {
+            wounds[defenders][target] = 0;
+            alive[defenders][slot] = alive[defenders].back();
+            alive[defenders].pop_back();
+            break;
+         }
+      }
+   }
+}
+
+/** Plays one battle and adds its outcome to a tally.
+
+"seed" is the seed of the whole run.
+"index" is the battle's index within the run.
+"maxTurns" is the turn limit.
+"tally" receives the outcome.
+
+Precondition: None.
+Postcondition: tally holds one more battle. */
+void BattleSimulator::playBattle(uint64_t seed, long long index, int maxTurns,
+   Tally& tally) const
+{
+   CounterRng generator(seed, (uint64_t)index);
+   vector<uint8_t> dice;
+   vector<int> wounds[2];
+   vector<int> alive[2];
+
+   for (int side = 0; side < 2; side++) {
+      const CharacterTable& table = sides_[side];
+      for (int unit = 0; unit < table.numUnits(); unit++) {
+         int startingWounds = table.stat(CharacterTable::W, unit);
+         wounds[side].push_back(startingWounds);
+         if (startingWounds > 0) alive[side].push_back(unit);
+      }
+      tally.alive[side].resize(maxTurns + 1, 0);
+      tally.alive[side][0] += alive[side].size();
+   }
+
+   int turn = 1;
+   for (; turn <= maxTurns; turn++) {
+      if (alive[0].empty() || alive[1].empty()) break;
+
+      takeTurn(0, wounds, alive, generator, dice);
+      takeTurn(1, wounds, alive, generator, dice);
+
+      for (int side = 0; side < 2; side++) {
+         tally.alive[side][turn] += alive[side].size();
+      }
+   }
+
+   //Battles that ended early hold their final numbers for the
+   //remaining turns.
+   for (; turn <= maxTurns; turn++) {
+      for (int side = 0; side < 2; side++) {
+         tally.alive[side][turn] += alive[side].size();
+      }
+   }
+
+   tally.battles++;
+   for (int side = 0; side < 2; side++) {
+      tally.survivors[side] += alive[side].size();
+   }
+
+   if (!alive[0].empty() && alive[1].empty()) tally.wins[0]++;
+   else if (alive[0].empty() && !alive[1].empty()) tally.wins[1]++;
+   else tally.draws++;
+}
+
+/** Plays the given number of battles.
+
+"battles" is the number of battles.
+"maxTurns" is the turn limit of each battle.
+"seed" seeds the battles.
+
+Precondition: None.
+Postcondition: Returns a BattleReport. No output is produced. */
+BattleReport BattleSimulator::run(long long battles, int maxTurns, uint64_t seed)
+{
+   if (maxTurns < 0) maxTurns = 0;
+
+   vector<unique_ptr<Tally>> tallies;
+   for (int i = 0; i < pool_.numWorkers(); i++) {
+      tallies.push_back(unique_ptr<Tally>(new Tally));
+   }
+
+   for (long long start = 0; start < battles; start += CHUNK_SIZE) {
+      long long end = (battles - start < CHUNK_SIZE) ? battles : start + CHUNK_SIZE;
+
+      pool_.submit([this, &tallies, seed, start, end, maxTurns](int worker) {
+         for (long long i = start; i < end; i++) {
+            playBattle(seed, i, maxTurns, *tallies[worker]);
+         }
+      });
+   }
+   pool_.wait();
+
+   //Merge the per-worker tallies.
+   Tally total;
+   for (int side = 0; side < 2; side++) {
+      total.alive[side].resize(maxTurns + 1, 0);
+   }
+   for (unique_ptr<Tally>& tally : tallies) {
+      total.battles += tally->battles;
+      total.draws += tally->draws;
+      for (int side = 0; side < 2; side++) {
+         total.wins[side] += tally->wins[side];
+         total.survivors[side] += tally->survivors[side];
+         for (int turn = 0; unsigned(turn) < tally->alive[side].size(); turn++) {
+            total.alive[side][turn] += tally->alive[side][turn];
+         }
+      }
+   }
+
+   BattleReport report;
+   report.battles = total.battles;
+   double count = (total.battles > 0) ? (double)total.battles : 1.0;
+   report.drawRate = total.draws / count;
+   for (int side = 0; side < 2; side++) {
+      report.winRate[side] = total.wins[side] / count;
+      report.meanSurvivors[side] = total.survivors[side] / count;
+      for (long long alive : total.alive[side]) {
+         report.attrition[side].push_back(alive / count);
+      }
+   }
+
+   return report;
+}
@@ -0,0 +1,107 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Plays whole battles between two Armies. Each turn the first army acts
+and then the second. Every living unit picks a random living enemy,
+shoots it with each of its ranged weapons and then fights it with each
+of its melee weapons. A battle ends when one side is wiped out or the
+turn limit is reached.
+
+Each unit's wounds are tracked per battle, separately from its base
+profile, so the Armies are never modified. Battles are spread across a
+WorkStealingPool and battle i is always seeded by its index, so a
+report depends only on the seed and not on the thread count. */
+
+#include "Army.h"
+#include "CharacterTable.h"
+#include "CombatRules.h"
+#include "CounterRng.h"
+#include "WorkStealingPool.h"
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+/** Summary of a batch of battles. Index 0 refers to the first army
+and index 1 to the second. attrition[side][turn] is the average number
+of that side's units still alive at the end of the turn, with turn 0
+being the start of the battle. Battles that end early count their final
+numbers for every remaining turn. */
+struct BattleReport
+{
+   long long battles;
+   double winRate[2];
+   double drawRate;
+   double meanSurvivors[2];
+   vector<double> attrition[2];
+};
+
+class BattleSimulator
+{
+private:
+   const long long CHUNK_SIZE = 64; //Battles per task
+
+   CharacterTable sides_[2];
+   WorkStealingPool pool_;
+   SamplingMode mode_;
+
+   struct Tally;
+
+   /** Plays one battle and adds its outcome to a tally.
+
+   "seed" is the seed of the whole run.
+   "index" is the battle's index within the run.
+   "maxTurns" is the turn limit.
+   "tally" receives the outcome.
+
+   Precondition: None.
+   Postcondition: tally holds one more battle. */
+   void playBattle(uint64_t seed, long long index, int maxTurns, Tally& tally) const;
+
+   /** One side attacks with every living unit.
+
+   "attackers" is the acting side's index.
+   "wounds" holds the remaining wounds of every unit on both sides.
+   "alive" holds the indices of the living units on both sides.
+   "generator" is the battle's generator.
+   "dice" is reused storage for the rolls.
+
+   Precondition: None.
+   Postcondition: Damage is applied to the other side, and units reduced
+   to 0 wounds are removed from alive. */
+   void takeTurn(int attackers, vector<int> wounds[2], vector<int> alive[2],
+      CounterRng& generator, vector<uint8_t>& dice) const;
+
+public:
+   /** Constructor that copies both armies into CharacterTables and starts
+   the worker threads.
+
+   "first" and "second" are the two Armies. They may be the same Army.
+   "numThreads" is the number of workers. If 0, one is started per
+   hardware thread.
+
+   Precondition: None.
+   Postcondition: Creates a BattleSimulator. */
+   BattleSimulator(const Army& first, const Army& second, int numThreads = 0);
+
+   /** Chooses how attacks are resolved. Defaults to BINOMIAL, since no
+   individual dice are ever shown.
+
+   "mode" is a SamplingMode.
+
+   Precondition: None.
+   Postcondition: Later runs use the given mode. */
+   void setSamplingMode(SamplingMode mode);
+
+   /** Plays the given number of battles.
+
+   "battles" is the number of battles.
+   "maxTurns" is the turn limit of each battle.
+   "seed" seeds the battles.
+
+   Precondition: None.
+   Postcondition: Returns a BattleReport. No output is produced. */
+   BattleReport run(long long battles, int maxTurns, uint64_t seed);
+};
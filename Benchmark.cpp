@@ -0,0 +1,303 @@
+/** @Benchmark.cpp */
+
+/** Microbenchmarks for the hot paths of Warhammer-Simulator: combat at
+several attack counts, string splitting, roster parsing, name lookups,
+completions and suggestions, and the CombatFactory. Built as its own
+executable, separately from main.cpp.
+
+Each benchmark is run for a growing number of iterations until it has
+taken at least MIN_SECONDS, and reports ns/op, heap allocations/op and
+ops/s. Allocations are counted by replacing the global operator new.
+
+Usage: Benchmark [--json] [--filter text]
+   --json     prints the results as a JSON array instead of a table
+   --filter   only runs benchmarks whose name contains the text
+
+Michael Patrick
+10/17/26 */
+
+#include "Army.h"
+#include "Character.h"
+#include "MeleeWeapon.h"
+#include "RangedWeapon.h"
+#include "CombatFactory.h"
+#include "Combat.h"
+#include "NullSink.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <functional>
+#include <cstdlib>
+#include <cstdio>
+#include <new>
+
+using namespace std;
+
+const double MIN_SECONDS = 0.25;          //Minimum time measured per benchmark
+const int ROSTER_SIZE = 2000;             //Units in the generated roster
+const char* ROSTER_FILE = "benchmark_roster.txt";
+
+//Counts every heap allocation made by the process.
+static atomic<long long> allocations(0);
+
+void* operator new(size_t size)
+{
+   allocations.fetch_add(1, memory_order_relaxed);
+   void* memory = malloc(size > 0 ? size : 1);
+   if (memory == nullptr) throw bad_alloc();
+   return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+   free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+   free(memory);
+}
+
+/** Result of one benchmark. */
+struct BenchmarkResult
+{
+   string name;
+   long long iterations;
+   double nsPerOp;
+   double allocationsPerOp;
+   double opsPerSecond;
+};
+
+/** Runs a benchmark body for a growing number of iterations until it
+takes at least MIN_SECONDS.
+
+"name" is the benchmark's name.
+"body" runs the operation the given number of times.
+
+Precondition: None.
+Postcondition: Returns a BenchmarkResult for the last, longest run. */
+BenchmarkResult measure(string name, const function<void(long long)>& body)
+{
+   body(1); //Warm up caches and any lazily built state
+
+   long long iterations = 1;
+   while (true) {
+      long long startAllocations = allocations.load();
+      auto start = chrono::steady_clock::now();
+      body(iterations);
+      auto stop = chrono::steady_clock::now();
+      long long usedAllocations = allocations.load() - startAllocations;
+
+      double seconds = chrono::duration<double>(stop - start).count();
+      if (seconds >= MIN_SECONDS || iterations >= (1LL << 40)) {
+         BenchmarkResult result;
+         result.name = name;
+         result.iterations = iterations;
+         result.nsPerOp = seconds * 1e9 / iterations;
+         result.allocationsPerOp = (double)usedAllocations / iterations;
+         result.opsPerSecond = iterations / seconds;
+         return result;
+      }
+
+      //Aim straight for the target once there's a usable estimate.
+      long long next = (seconds > 0.01)
+         ? (long long)(iterations * MIN_SECONDS * 1.2 / seconds) : iterations * 10;
+      iterations = (next > iterations) ? next : iterations + 1;
+   }
+}
+
+/** Writes a roster of generated units in the format Army reads.
+
+"fileName" is the file to write.
+"units" is the number of units.
+
+Precondition: None.
+Postcondition: The roster file is written. */
+void writeRoster(string fileName, int units)
+{
+   ofstream roster(fileName);
+   for (int i = 0; i < units; i++) {
+      char name[16];
+      snprintf(name, sizeof(name), "Unit%05d", i);
+
+      roster << name << "\n"
+         << 6 << " " << 2 + i % 4 << " " << 2 + (i / 4) % 4 << " " << 3 + i % 5
+         << " " << 3 + (i / 5) % 5 << " " << 1 + i % 8 << " " << 1 + i % 6
+         << " 7 " << 2 + i % 5 << " " << ((i % 7 == 0) ? 4 : 0) << "\n"
+         << "None\n"
+         << "Ranged Gun" << i << " 24 Assault " << 1 + i % 10 << " " << 3 + i % 6
+         << " " << i % 4 << " " << 1 + i % 3 << " None \n"
+         << "Melee Blade" << i << " " << i % 3 << " " << i % 4 << " " << 1 + i % 2
+         << " None";
+      if (i + 1 < units) roster << "\n\n";
+   }
+}
+
+/** Returns whether a benchmark should run under the filter.
+
+Precondition: None.
+Postcondition: Returns a bool. */
+bool selected(const string& name, const string& filter)
+{
+   return filter.empty() || name.find(filter) != string::npos;
+}
+
+int main(int argc, char* argv[])
+{
+   bool json = false;
+   string filter;
+   for (int i = 1; i < argc; i++) {
+      string argument = argv[i];
+      if (argument == "--json") {
+         json = true;
+      }
+      else if (argument == "--filter" && i + 1 < argc) {
+         filter = argv[++i];
+      }
+   }
+
+   vector<BenchmarkResult> results;
+   NullSink sink;
+
+   //Character::combat, through meleeAttack, at several attack counts.
+   //The defender has wounds enough never to die, and the NullSink keeps
+   //printing out of the measurement.
+   int attackCounts[] = { 1, 10, 100, 1000 };
+   for (int attacks : attackCounts) {
+      string name = "combat/attacks=" + to_string(attacks);
+      if (!selected(name, filter)) continue;
+
+      Character attacker;
+      attacker.setStats("6 3 3 4 4 5 " + to_string(attacks) + " 7 3 0");
+      attacker.setMeleeNew("Blade 1 1 2 None");
+      Character defender;
+      defender.setStats("6 3 3 4 4 2000000000 1 7 3 5");
+      attacker.setEventSink(&sink);
+      MeleeWeapon* weapon = attacker.getMeleeAt(0);
+
+      results.push_back(measure(name, [&](long long iterations) {
+         for (long long i = 0; i < iterations; i++) {
+            attacker.meleeAttack(defender, weapon);
+         }
+      }));
+   }
+
+   //Character::split on a typical stat line.
+   if (selected("split", filter)) {
+      Character character;
+      string statLine = "6 3 3 4 4 5 3 7 3 5";
+
+      results.push_back(measure("split", [&](long long iterations) {
+         for (long long i = 0; i < iterations; i++) {
+            vector<string>* words = character.split(" ", statLine);
+            delete words;
+         }
+      }));
+   }
+
+   writeRoster(ROSTER_FILE, ROSTER_SIZE);
+
+   //Parsing a whole roster. Throughput is in rosters/s; divide by
+   //ROSTER_SIZE for units/s.
+   string parseName = "army_parse/units=" + to_string(ROSTER_SIZE);
+   if (selected(parseName, filter)) {
+      results.push_back(measure(parseName, [&](long long iterations) {
+         for (long long i = 0; i < iterations; i++) {
+            Army army(ROSTER_FILE);
+         }
+      }));
+   }
+
+   //Name lookups spread across the roster. Only hits are measured, since
+   //a miss prints a message that would swamp the lookup itself.
+   if (selected("army_retrieve", filter)) {
+      Army army(ROSTER_FILE);
+      vector<string> names;
+      for (int i = 0; i < 64; i++) {
+         char name[16];
+         snprintf(name, sizeof(name), "Unit%05d", (i * 7919) % ROSTER_SIZE);
+         names.push_back(name);
+      }
+
+      results.push_back(measure("army_retrieve", [&](long long iterations) {
+         int found = 0;
+         for (long long i = 0; i < iterations; i++) {
+            if (army.retrieve(names[i & 63]) != nullptr) found++;
+         }
+         if (found < 0) cout << found; //Keeps the lookups from being optimised out
+      }));
+   }
+
+   //Completing a partly typed name and correcting a mistyped one, as
+   //main.cpp does when a name isn't found.
+   if (selected("army_complete", filter) || selected("army_suggest", filter)) {
+      Army army(ROSTER_FILE);
+      vector<string> typed;
+      for (int i = 0; i < 64; i++) {
+         char name[16];
+         snprintf(name, sizeof(name), "unit%05d", (i * 7919) % ROSTER_SIZE);
+         name[4 + i % 5] = 'x'; //One wrong letter
+         typed.push_back(name);
+      }
+
+      if (selected("army_complete", filter)) {
+         results.push_back(measure("army_complete", [&](long long iterations) {
+            size_t found = 0;
+            for (long long i = 0; i < iterations; i++) {
+               found += army.complete(string_view(typed[i & 63]).substr(0, 7), 5).size();
+            }
+            if (found == 1) cout << "";
+         }));
+      }
+      if (selected("army_suggest", filter)) {
+         results.push_back(measure("army_suggest", [&](long long iterations) {
+            size_t found = 0;
+            for (long long i = 0; i < iterations; i++) {
+               found += army.suggest(typed[i & 63], 2, 5).size();
+            }
+            if (found == 1) cout << "";
+         }));
+      }
+   }
+
+   remove(ROSTER_FILE);
+
+   //CombatFactory lookups, alternating between the two combat types.
+   if (selected("combat_factory", filter)) {
+      CombatFactory factory;
+      string inputs[2] = { "melee", "ranged" };
+
+      results.push_back(measure("combat_factory", [&](long long iterations) {
+         Combat* last = nullptr;
+         for (long long i = 0; i < iterations; i++) {
+            last = factory.generateCombatObject(inputs[i & 1]);
+         }
+         if (last == nullptr) cout << "";
+      }));
+   }
+
+   if (json) {
+      cout << "[\n";
+      for (int i = 0; unsigned(i) < results.size(); i++) {
+         const BenchmarkResult& result = results[i];
+         cout << "  {\"name\": \"" << result.name << "\", \"iterations\": "
+            << result.iterations << ", \"ns_per_op\": " << result.nsPerOp
+            << ", \"allocations_per_op\": " << result.allocationsPerOp
+            << ", \"ops_per_second\": " << result.opsPerSecond << "}"
+            << ((unsigned(i) + 1 < results.size()) ? ",\n" : "\n");
+      }
+      cout << "]\n";
+      return 0;
+   }
+
+   printf("%-28s %14s %12s %14s\n", "benchmark", "ns/op", "allocs/op", "ops/s");
+   for (const BenchmarkResult& result : results) {
+      printf("%-28s %14.1f %12.2f %14.0f\n", result.name.c_str(), result.nsPerOp,
+         result.allocationsPerOp, result.opsPerSecond);
+   }
+   return 0;
+}
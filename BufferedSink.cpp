@@ -0,0 +1,151 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Inherits the CombatEventSink class, and records every event of a fight
+as a structured CombatEvent in memory. */
+
+#include "BufferedSink.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** Constructor.
+
+"keepRolls" is whether individual dice are recorded.
+
+Precondition: None.
+Postcondition: Creates an empty BufferedSink. */
+BufferedSink::BufferedSink(bool keepRolls) : keepRolls_(keepRolls)
+{
+}
+
+/** Appends one event.
+
+"type" is the CombatEventType.
+"stage" is the CombatStage, if the event has one.
+"value", "extra" and "stat" are as described for CombatEvent.
+
+Precondition: None.
+Postcondition: The event is the newest in events(). */
+void BufferedSink::record(CombatEventType type, CombatStage stage, int value, int extra,
+   const string& stat)
+{
+   events_.push_back({ type, stage, value, extra, stat });
+}
+
+/** Returns the events recorded so far, oldest first.
+
+Precondition: None.
+Postcondition: Returns a const reference to a vector. */
+const vector<CombatEvent>& BufferedSink::events() const
+{
+   return events_;
+}
+
+/** Drops every recorded event.
+
+Precondition: None.
+Postcondition: The sink is empty. */
+void BufferedSink::clear()
+{
+   events_.clear();
+}
+
+/** Returns whether individual dice are recorded, as chosen when
+the sink was made.
+
+Precondition: None.
+Postcondition: Returns a bool. */
+bool BufferedSink::wantsRolls() const
+{
+   return keepRolls_;
+}
+
+/** Records a FIGHT_SKIPPED event.
+
+"attackerDead" is true if the attacker is dead, false if the
+defender is.
+
+Precondition: None.
+Postcondition: The event is the newest in events(). */
+void BufferedSink::fightSkipped(bool attackerDead)
+{
+   record(FIGHT_SKIPPED, HIT_STAGE, attackerDead ? 1 : 0, 0);
+}
+
+/** Records a FIGHT_STARTED event.
+
+"stat" is "WS" or "BS".
+"hitStat" is the attacker's value of that characteristic.
+"damage" is the damage of each unsaved wound.
+
+Precondition: None.
+Postcondition: The event is the newest in events(). */
+void BufferedSink::fightStarted(const string& stat, int hitStat, int damage)
+{
+   record(FIGHT_STARTED, HIT_STAGE, hitStat, damage, stat);
+}
+
+/** Records a STAGE_STARTED event.
+
+"stage" is the CombatStage.
+"threshold" is the roll needed to hit or wound, or the save rolled
+against.
+
+Precondition: None.
+Postcondition: The event is the newest in events(). */
+void BufferedSink::stageStarted(CombatStage stage, int threshold)
+{
+   record(STAGE_STARTED, stage, threshold, 0);
+}
+
+/** Records a DIE_ROLLED event.
+
+"stage" is the CombatStage it belongs to.
+"roll" is the result, 1-6.
+
+Precondition: None.
+Postcondition: The event is the newest in events(). */
+void BufferedSink::dieRolled(CombatStage stage, int roll)
+{
+   record(DIE_ROLLED, stage, roll, 0);
+}
+
+/** Records a STAGE_DRAWN event.
+
+"stage" is the CombatStage.
+"count" is the number of dice the successes were drawn from.
+
+Precondition: None.
+Postcondition: The event is the newest in events(). */
+void BufferedSink::stageDrawn(CombatStage stage, int count)
+{
+   record(STAGE_DRAWN, stage, count, 0);
+}
+
+/** Records a STAGE_FINISHED event.
+
+"stage" is the CombatStage.
+"result" is the number of hits, the number of wounds, or for the
+save stage the number of failed saves.
+
+Precondition: None.
+Postcondition: The event is the newest in events(). */
+void BufferedSink::stageFinished(CombatStage stage, int result)
+{
+   record(STAGE_FINISHED, stage, result, 0);
+}
+
+/** Records a FIGHT_FINISHED event.
+
+"damage" is the total damage done.
+"woundsLeft" is the defender's remaining wounds.
+
+Precondition: None.
+Postcondition: The event is the newest in events(). */
+void BufferedSink::fightFinished(int damage, int woundsLeft)
+{
+   record(FIGHT_FINISHED, SAVE_STAGE, damage, woundsLeft);
+}
@@ -0,0 +1,152 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Inherits the CombatEventSink class, and records every event of a fight
+as a structured CombatEvent in memory, for callers that want to inspect
+or post-process fights rather than read them. */
+
+#include "CombatEventSink.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** Kinds of recorded event, one per CombatEventSink method. */
+enum CombatEventType { FIGHT_SKIPPED, FIGHT_STARTED, STAGE_STARTED, DIE_ROLLED,
+   STAGE_DRAWN, STAGE_FINISHED, FIGHT_FINISHED };
+
+/** One recorded event. The meaning of value and extra depends on type:
+
+FIGHT_SKIPPED  - value is 1 if the attacker was dead, 0 if the defender was
+FIGHT_STARTED  - value is the hit characteristic, extra the damage per wound,
+                 stat "WS" or "BS"
+STAGE_STARTED  - value is the threshold
+DIE_ROLLED     - value is the roll
+STAGE_DRAWN    - value is the number of dice the successes were drawn from
+STAGE_FINISHED - value is the stage's result
+FIGHT_FINISHED - value is the damage done, extra the wounds left
+
+stage is only meaningful for the STAGE_ and DIE_ events, and stat only
+for FIGHT_STARTED, being empty otherwise. */
+struct CombatEvent
+{
+   CombatEventType type;
+   CombatStage stage;
+   int value;
+   int extra;
+   string stat;
+};
+
+class BufferedSink : public CombatEventSink
+{
+private:
+   vector<CombatEvent> events_;
+   bool keepRolls_;
+
+   /** Appends one event.
+
+   "type" is the CombatEventType.
+   "stage" is the CombatStage, if the event has one.
+   "value", "extra" and "stat" are as described for CombatEvent.
+
+   Precondition: None.
+   Postcondition: The event is the newest in events(). */
+   void record(CombatEventType type, CombatStage stage, int value, int extra,
+      const string& stat = "");
+
+public:
+   /** Constructor.
+
+   "keepRolls" is whether individual dice are recorded.
+
+   Precondition: None.
+   Postcondition: Creates an empty BufferedSink. */
+   BufferedSink(bool keepRolls = true);
+
+   /** Returns the events recorded so far, oldest first.
+
+   Precondition: None.
+   Postcondition: Returns a const reference to a vector. */
+   const vector<CombatEvent>& events() const;
+
+   /** Drops every recorded event.
+
+   Precondition: None.
+   Postcondition: The sink is empty. */
+   void clear();
+
+   /** Returns whether individual dice are recorded, as chosen when
+   the sink was made.
+
+   Precondition: None.
+   Postcondition: Returns a bool. */
+   virtual bool wantsRolls() const;
+
+   /** Records a FIGHT_SKIPPED event.
+
+   "attackerDead" is true if the attacker is dead, false if the
+   defender is.
+
+   Precondition: None.
+   Postcondition: The event is the newest in events(). */
+   virtual void fightSkipped(bool attackerDead);
+
+   /** Records a FIGHT_STARTED event.
+
+   "stat" is "WS" or "BS".
+   "hitStat" is the attacker's value of that characteristic.
+   "damage" is the damage of each unsaved wound.
+
+   Precondition: None.
+   Postcondition: The event is the newest in events(). */
+   virtual void fightStarted(const string& stat, int hitStat, int damage);
+
+   /** Records a STAGE_STARTED event.
+
+   "stage" is the CombatStage.
+   "threshold" is the roll needed to hit or wound, or the save rolled
+   against.
+
+   Precondition: None.
+   Postcondition: The event is the newest in events(). */
+   virtual void stageStarted(CombatStage stage, int threshold);
+
+   /** Records a DIE_ROLLED event.
+
+   "stage" is the CombatStage it belongs to.
+   "roll" is the result, 1-6.
+
+   Precondition: None.
+   Postcondition: The event is the newest in events(). */
+   virtual void dieRolled(CombatStage stage, int roll);
+
+   /** Records a STAGE_DRAWN event.
+
+   "stage" is the CombatStage.
+   "count" is the number of dice the successes were drawn from.
+
+   Precondition: None.
+   Postcondition: The event is the newest in events(). */
+   virtual void stageDrawn(CombatStage stage, int count);
+
+   /** Records a STAGE_FINISHED event.
+
+   "stage" is the CombatStage.
+   "result" is the number of hits, the number of wounds, or for the
+   save stage the number of failed saves.
+
+   Precondition: None.
+   Postcondition: The event is the newest in events(). */
+   virtual void stageFinished(CombatStage stage, int result);
+
+   /** Records a FIGHT_FINISHED event.
+
+   "damage" is the total damage done.
+   "woundsLeft" is the defender's remaining wounds.
+
+   Precondition: None.
+   Postcondition: The event is the newest in events(). */
+   virtual void fightFinished(int damage, int woundsLeft);
+};
@@ -8,14 +8,30 @@ engaging in combat with other characters. */
 #include "Character.h"
 #include "MeleeWeapon.h"
 #include "RangedWeapon.h"
+#include "CombatRules.h"
+#include "CounterRng.h"
+#include "DiceKernel.h"
+#include "ConsoleSink.h"
+#include "CombatStats.h"
 #include <string>
 #include <iostream>
 #include <vector>
 #include <random>
 #include <chrono>
+#include <atomic>
+#include <cstdint>
 
 using namespace std;
 
+//Seed shared by every fight, and the number of fights rolled under it.
+//Each fight takes the next stream, so two fights never repeat rolls.
+static atomic<uint64_t> diceSeed(
+   (uint64_t)chrono::system_clock::now().time_since_epoch().count());
+static atomic<uint64_t> fightCount(0);
+
+//Where fights are reported unless a character is given its own sink.
+static ConsoleSink defaultSink;
+
 /** Default constructor for a character. Doesn't need to have anything allocated
 at the start. Defaults all fields to default values.
 
@@ -25,6 +41,8 @@ Character::Character()
 {
    name_ = "[Unnamed]";
    psyker_ = false;
+   samplingMode_ = DIE_BY_DIE;
+   sink_ = &defaultSink;
 
 }
 
@@ -364,37 +382,30 @@ combat respectively.
 
 Precondition: None. Returns prematurely if the enemy or self has
 a W(ound) stat of 0.
-Postcondition: Outputs dice rolls and combat results to output,
-and changes the W stat of the enemy. */
+Postcondition: Reports dice rolls and combat results to the event
+sink, and changes the W stat of the enemy. */
 void Character::combat(Character& enemy, int hitStats, int userStrength, int weaponStrength,
    int weaponAP, int weaponDamage, string stat)
 {
    if (enemy.stats_[5] <= 0) {
-      cout << "Enemy character is already dead...";
+      sink_->fightSkipped(false);
       return;
    }
    else if (stats_[5] <= 0) {
-      cout << "Attacking character is already dead...";
+      sink_->fightSkipped(true);
       return;
    }
 
-   unsigned seed = (unsigned)chrono::system_clock::now().time_since_epoch().count();
-   cout << "Rolling to hit with " << stat << " " << hitStats << "..." << endl;
-   default_random_engine generator(seed);
-   uniform_int_distribution<int> diceRoll(1, 6);
-   vector<int> potentialDamage;
+   bool instrumented = CombatStats::enabled();
+   long long start = instrumented ? CombatStats::now() : 0;
 
-   //Calculating Hits
-   int totalHits = 0;
-   for (int i = 0; i < stats_[6]; i++) {
-      int roll = diceRoll(generator);
-      cout << roll << " ";
+   sink_->fightStarted(stat, hitStats, weaponDamage);
+   CounterRng generator(diceSeed, fightCount++);
 
-      if (roll >= hitStats) {
-         totalHits++;
-      }
-   }
-   cout << endl << "Total number of hits: " << totalHits << endl;
+   //Calculating Hits
+   sink_->stageStarted(HIT_STAGE, hitStats);
+   int totalHits = rollStage(generator, HIT_STAGE, stats_[6], hitStats, instrumented);
+   sink_->stageFinished(HIT_STAGE, totalHits);
 
    //Calculating Wounds
    int str = weaponStrength;
@@ -402,60 +413,120 @@ void Character::combat(Character& enemy, int hitStats, int userStrength, int wea
    int tough = enemy.stats_[4];
 
    //Rules for wounds...
-   int woundRoll;
-   if (str / 2 >= tough) {
-      woundRoll = 2;
-   }
-   else if (str > tough) {
-      woundRoll = 3;
-   }
-   else if (str == tough) {
-      woundRoll = 4;
-   }
-   else if (tough / 2 >= str) {
-      woundRoll = 6;
+   int toWound = woundRoll(str, tough);
+
+   sink_->stageStarted(WOUND_STAGE, toWound);
+   int totalWounds = rollStage(generator, WOUND_STAGE, totalHits, toWound, instrumented);
+   sink_->stageFinished(WOUND_STAGE, totalWounds);
+
+   int armorSave = enemy.stats_[8];
+   int invulnSave = enemy.stats_[9];
+   int saveRoll = bestSave(armorSave, invulnSave, weaponAP);
+
+   sink_->stageStarted(SAVE_STAGE, saveRoll);
+   int succesfulHits = totalWounds - rollStage(generator, SAVE_STAGE, totalWounds, saveRoll,
+      instrumented);
+   sink_->stageFinished(SAVE_STAGE, succesfulHits);
+
+   int dmg = succesfulHits * weaponDamage;
+   enemy.stats_[5] -= dmg;
+
+   sink_->fightFinished(dmg, enemy.stats_[5]);
+
+   if (instrumented) CombatStats::addFight(dmg, CombatStats::now() - start);
+}
+
+/** Seeds the dice rolled by every Character's combat. Each fight
+after this draws from its own stream under the seed, so a sequence
+of fights can be replayed exactly by seeding again with the same
+value.
+
+"seed" is a 64-bit seed.
+
+Precondition: None.
+Postcondition: Subsequent fights roll from the new seed. */
+void Character::seedDice(unsigned long long seed)
+{
+   diceSeed = seed;
+   fightCount = 0;
+}
+
+/** Private helper function that resolves one stage of combat rolls.
+Rolls every die in DIE_BY_DIE mode, reporting each to the event sink.
+In BINOMIAL mode the number of successes is drawn directly, and the
+sink is told the stage was drawn.
+
+"generator" is the generator for the current fight.
+"stage" is the CombatStage being rolled.
+"count" is the number of dice in the stage.
+"threshold" is the roll needed to succeed.
+"instrumented" is whether to record the stage in CombatStats.
+
+Precondition: None.
+Postcondition: Returns the number of dice that rolled threshold or
+higher. */
+int Character::rollStage(CounterRng& generator, CombatStage stage, int count,
+   int threshold, bool instrumented) const
+{
+   long long start = instrumented ? CombatStats::now() : 0;
+   long long reportNanos = 0;
+   int result;
+
+   if (samplingMode_ == BINOMIAL) {
+      result = DiceKernel::binomialCount(generator, count, threshold);
+      sink_->stageDrawn(stage, count);
    }
    else {
-      woundRoll = 5;
+      //Reused between stages so steady-state rolling never allocates.
+      static thread_local vector<uint8_t> dice;
+
+      if (sink_->wantsRolls()) {
+         DiceKernel::roll(generator, count, dice);
+         long long reportStart = instrumented ? CombatStats::now() : 0;
+         for (uint8_t roll : dice) {
+            sink_->dieRolled(stage, roll);
+         }
+         if (instrumented) reportNanos = CombatStats::now() - reportStart;
+         result = DiceKernel::countAtLeast(dice.data(), (int)dice.size(), threshold);
+      }
+      else {
+         result = DiceKernel::rollAndCount(generator, count, threshold, dice);
+      }
    }
 
-   cout << "Wounding on " << woundRoll << "s.." << endl;
+   if (instrumented) {
+      //Saves are counted by the ones that fail.
+      CombatStats::addStage(stage, count, (stage == SAVE_STAGE) ? count - result : result,
+         samplingMode_ == BINOMIAL, CombatStats::now() - start - reportNanos, reportNanos);
+   }
+   return result;
+}
 
-   int totalWounds = 0;
-   for (int i = 0; i < totalHits; i++) {
-      int roll = diceRoll(generator);
-      cout << roll << " ";
+/** Chooses how this character's attacks resolve each stage of rolls.
+DIE_BY_DIE (the default) rolls and reports every die. BINOMIAL draws
+the number of hits, wounds and failed saves directly, reporting only
+the totals, which is much faster for large volleys.
 
-      if (roll >= woundRoll) {
-         totalWounds++;
-      }
-   }
+"mode" is a SamplingMode.
 
-   cout << endl << "Total wounds: " << totalWounds << endl;
+Precondition: None.
+Postcondition: Later attacks use the given mode. */
+void Character::setSamplingMode(SamplingMode mode)
+{
+   samplingMode_ = mode;
+}
 
-   int armorSave = enemy.stats_[8];
-   int invulnSave = enemy.stats_[9];
-   int bestSave = ((armorSave - weaponAP) >= invulnSave) ?
-      (armorSave - weaponAP) : invulnSave;
-
-   cout << "Each hit does " << to_string(weaponDamage) << " damage." << endl;
-   cout << "Saving on " << bestSave << "s." << endl;
-   int dmg = 0;
-   int succesfulHits = 0;
-   for (int i = 0; i < totalWounds; i++) {
-      int roll = diceRoll(generator);
-      cout << roll << " ";
-
-      if (roll < bestSave) {
-         dmg += weaponDamage;
-         succesfulHits++;
-      }
-   }
-   cout << endl << succesfulHits << " succesful wounds." << endl;
-   cout << dmg << " damage done!" << endl;
-   enemy.stats_[5] -= dmg;
-   
-   cout << "Target has " << enemy.stats_[5] << " health left!";
+/** Chooses where this character's attacks report the events of each
+fight. By default they go to a ConsoleSink printing to cout.
+
+"sink" is a CombatEventSink pointer, owned by the caller. Passing
+nullptr restores the default.
+
+Precondition: The sink must outlive its use by this character.
+Postcondition: Later attacks report to the given sink. */
+void Character::setEventSink(CombatEventSink* sink)
+{
+   sink_ = (sink != nullptr) ? sink : &defaultSink;
 }
 
 /** Performs a ranged attack upon an enemy character.
@@ -493,13 +564,96 @@ void Character::meleeAttack(Character& enemy, MeleeWeapon* weapon, string stat)
       weapon->getAP(), weapon->getDamage(), stat);
 }
 
+/** Returns the character's movement value (in inches).
+
+Precondition: None.
+Postcondition: Returns an int. */
+int Character::getMovement() const
+{
+   return stats_[0];
+}
+
+/** Returns the character's weapon skill.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int Character::getWS() const
+{
+   return stats_[1];
+}
+
+/** Returns the character's ballistic skill.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int Character::getBS() const
+{
+   return stats_[2];
+}
+
 /** Returns the character's strength value.
 
 Precondition: None.
 Postcondition: Returns an int. */
 int Character::getStrength() const
 {
-   return strength_;
+   return stats_[3];
+}
+
+/** Returns the character's toughness value.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int Character::getToughness() const
+{
+   return stats_[4];
+}
+
+/** Returns the character's remaining wounds.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int Character::getWounds() const
+{
+   return stats_[5];
+}
+
+/** Returns the character's number of attacks (usually for
+melee weapons)
+
+Precondition: None.
+Postcondition: Returns an int. */
+int Character::getAttacks() const
+{
+   return stats_[6];
+}
+
+/** Returns the character's leadership stat.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int Character::getLeadership() const
+{
+   return stats_[7];
+}
+
+/** Returns the character's armor save.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int Character::getArmorSave() const
+{
+   return stats_[8];
+}
+
+/** Returns the character's invuln save.
+
+Precondition: None.
+Postcondition: Returns an int. If a character has no invuln save,
+returns 0 instead. */
+int Character::getInvulnSave() const
+{
+   return stats_[9];
 }
 
 /** Returns the specified melee weapon from the weapon list.
@@ -530,4 +684,52 @@ RangedWeapon* Character::getRangedAt(int index)
    if (index >= (int)rangedList_.size())
       retrieve = rangedList_.size() - 1;
    return rangedList_.at(retrieve);
+}
+
+/** Returns the number of melee weapons the character carries.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int Character::numMeleeWeapons() const
+{
+   return (int)meleeList_.size();
+}
+
+/** Returns the number of ranged weapons the character carries.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int Character::numRangedWeapons() const
+{
+   return (int)rangedList_.size();
+}
+
+/** Builds the CombatProfile for a ranged attack upon an enemy character
+with the given weapon, using the same characteristics as rangedAttack.
+
+"enemy" is the defending Character.
+"weapon" is a RangedWeapon pointer.
+
+Precondition: None.
+Postcondition: Returns a CombatProfile. Neither Character is modified. */
+CombatProfile Character::rangedProfile(const Character& enemy, const RangedWeapon* weapon) const
+{
+   return { stats_[2], stats_[6], weapon->getStrength(), weapon->getAP(),
+      weapon->getDamage(), enemy.stats_[4], enemy.stats_[8], enemy.stats_[9],
+      enemy.stats_[5] };
+}
+
+/** Builds the CombatProfile for a melee attack upon an enemy character
+with the given weapon, using the same characteristics as meleeAttack.
+
+"enemy" is the defending Character.
+"weapon" is a MeleeWeapon pointer.
+
+Precondition: None.
+Postcondition: Returns a CombatProfile. Neither Character is modified. */
+CombatProfile Character::meleeProfile(const Character& enemy, const MeleeWeapon* weapon) const
+{
+   return { stats_[1], stats_[6], weapon->getStrength(), weapon->getAP(),
+      weapon->getDamage(), enemy.stats_[4], enemy.stats_[8], enemy.stats_[9],
+      enemy.stats_[5] };
 }
\ No newline at end of file
@@ -9,6 +9,10 @@ engaging in combat with other characters. */
 
 #include "MeleeWeapon.h"
 #include "RangedWeapon.h"
+#include "CombatProfile.h"
+#include "CombatRules.h"
+#include "CounterRng.h"
+#include "CombatEventSink.h"
 #include <string>
 #include <iostream>
 #include <vector>
@@ -58,13 +62,32 @@ private:
    vector<RangedWeapon*> rangedList_; //Handle 
    vector<MeleeWeapon*> meleeList_;
 
+   SamplingMode samplingMode_; //How combat resolves each stage of rolls
+   CombatEventSink* sink_;     //Where combat reports what happens
+
+   /** Private helper function that resolves one stage of combat rolls.
+   Rolls every die in DIE_BY_DIE mode, reporting each to the event sink.
+   In BINOMIAL mode the number of successes is drawn directly.
+
+   "generator" is the generator for the current fight.
+   "stage" is the CombatStage being rolled.
+   "count" is the number of dice in the stage.
+   "threshold" is the roll needed to succeed.
+   "instrumented" is whether to record the stage in CombatStats.
+
+   Precondition: None.
+   Postcondition: Returns the number of dice that rolled threshold or
+   higher. */
+   int rollStage(CounterRng& generator, CombatStage stage, int count, int threshold,
+      bool instrumented) const;
+
    /** Private helper function that generalizes weapon combat for
    either melee or ranged combat.
    
    Precondition: None. Returns prematurely if the enemy or self has
    a W(ound) stat of 0.
-   Postcondition: Outputs dice rolls and combat results to output,
-   and changes the W stat of the enemy. */
+   Postcondition: Reports dice rolls and combat results to the event
+   sink, and changes the W stat of the enemy. */
    void combat(Character& enemy, int hitStats, int userStrength, int weaponStrength,
       int weaponAP, int weaponDamage, string stat);
 
@@ -295,6 +318,38 @@ public:
    Postcondition: Casts psychic ability on self for that round. */
    void psychicSelf(int ability);
 
+   /** Seeds the dice rolled by every Character's combat. Each fight
+   after this draws from its own stream under the seed, so a sequence
+   of fights can be replayed exactly by seeding again with the same
+   value.
+
+   "seed" is a 64-bit seed.
+
+   Precondition: None.
+   Postcondition: Subsequent fights roll from the new seed. */
+   static void seedDice(unsigned long long seed);
+
+   /** Chooses how this character's attacks resolve each stage of rolls.
+   DIE_BY_DIE (the default) rolls and reports every die. BINOMIAL draws
+   the number of hits, wounds and failed saves directly, reporting only
+   the totals, which is much faster for large volleys.
+
+   "mode" is a SamplingMode.
+
+   Precondition: None.
+   Postcondition: Later attacks use the given mode. */
+   void setSamplingMode(SamplingMode mode);
+
+   /** Chooses where this character's attacks report the events of each
+   fight. By default they go to a ConsoleSink printing to cout.
+
+   "sink" is a CombatEventSink pointer, owned by the caller. Passing
+   nullptr restores the default.
+
+   Precondition: The sink must outlive its use by this character.
+   Postcondition: Later attacks report to the given sink. */
+   void setEventSink(CombatEventSink* sink);
+
    /** Performs a ranged attack upon an enemy character.
    
    "enemy" is another character passed by value.
@@ -376,4 +431,36 @@ public:
    Precondition: None.
    Postcondition: Returns a RangedWeapon pointer. */
    RangedWeapon* getRangedAt(int index);
+
+   /** Returns the number of melee weapons the character carries.
+
+   Precondition: None.
+   Postcondition: Returns an int. */
+   int numMeleeWeapons() const;
+
+   /** Returns the number of ranged weapons the character carries.
+
+   Precondition: None.
+   Postcondition: Returns an int. */
+   int numRangedWeapons() const;
+
+   /** Builds the CombatProfile for a ranged attack upon an enemy character
+   with the given weapon, using the same characteristics as rangedAttack.
+
+   "enemy" is the defending Character.
+   "weapon" is a RangedWeapon pointer.
+
+   Precondition: None.
+   Postcondition: Returns a CombatProfile. Neither Character is modified. */
+   CombatProfile rangedProfile(const Character& enemy, const RangedWeapon* weapon) const;
+
+   /** Builds the CombatProfile for a melee attack upon an enemy character
+   with the given weapon, using the same characteristics as meleeAttack.
+
+   "enemy" is the defending Character.
+   "weapon" is a MeleeWeapon pointer.
+
+   Precondition: None.
+   Postcondition: Returns a CombatProfile. Neither Character is modified. */
+   CombatProfile meleeProfile(const Character& enemy, const MeleeWeapon* weapon) const;
 };
\ No newline at end of file
@@ -0,0 +1,214 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Packed structure-of-arrays copy of an Army for batch simulation. Each
+combat characteristic is stored as its own contiguous column of 32-bit
+integers, one entry per unit, and weapons are flattened into columns
+indexed through weaponStart_. */
+
+#include "CharacterTable.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+/** Builds the table from every Character in an Army, in name order.
+
+"army" is the Army to copy.
+
+Precondition: None.
+Postcondition: Creates a CharacterTable. The Army is not modified, and
+later changes to it are not reflected in the table. */
+CharacterTable::CharacterTable(const Army& army)
+{
+   units_ = army.getCharacters();
+
+   for (int i = 0; i < NUM_COLUMNS; i++) {
+      columns_[i].reserve(units_.size());
+   }
+   names_.reserve(units_.size());
+   weaponStart_.reserve(units_.size() + 1);
+   weaponStart_.push_back(0);
+
+   for (Character* unit : units_) {
+      names_.push_back(unit->getName());
+
+      columns_[WS].push_back(unit->getWS());
+      columns_[BS].push_back(unit->getBS());
+      columns_[S].push_back(unit->getStrength());
+      columns_[T].push_back(unit->getToughness());
+      columns_[W].push_back(unit->getWounds());
+      columns_[A].push_back(unit->getAttacks());
+      columns_[SV].push_back(unit->getArmorSave());
+      columns_[INV].push_back(unit->getInvulnSave());
+
+      for (int i = 0; i < unit->numRangedWeapons(); i++) {
+         RangedWeapon* weapon = unit->getRangedAt(i);
+         weaponNames_.push_back(weapon->getName());
+         weaponColumns_[WEAPON_S].push_back(weapon->getStrength());
+         weaponColumns_[WEAPON_AP].push_back(weapon->getAP());
+         weaponColumns_[WEAPON_D].push_back(weapon->getDamage());
+         weaponColumns_[WEAPON_SHOTS].push_back(weapon->getAttacks());
+         weaponColumns_[WEAPON_MELEE].push_back(0);
+      }
+
+      for (int i = 0; i < unit->numMeleeWeapons(); i++) {
+         MeleeWeapon* weapon = unit->getMeleeAt(i);
+         weaponNames_.push_back(weapon->getName());
+         weaponColumns_[WEAPON_S].push_back(weapon->getStrength());
+         weaponColumns_[WEAPON_AP].push_back(weapon->getAP());
+         weaponColumns_[WEAPON_D].push_back(weapon->getDamage());
+         weaponColumns_[WEAPON_SHOTS].push_back(0);
+         weaponColumns_[WEAPON_MELEE].push_back(1);
+      }
+
+      weaponStart_.push_back((int)weaponColumns_[WEAPON_S].size());
+   }
+}
+
+/** Returns the number of units.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int CharacterTable::numUnits() const
+{
+   return (int)units_.size();
+}
+
+/** Returns the total number of weapons across all units.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int CharacterTable::numWeapons() const
+{
+   return weaponStart_.back();
+}
+
+/** Returns a pointer to the start of one column, numUnits() long.
+
+"column" is a Column.
+
+Precondition: None.
+Postcondition: Returns a const int32_t pointer. */
+const int32_t* CharacterTable::column(Column column) const
+{
+   return columns_[column].data();
+}
+
+/** Returns one unit's value in a column.
+
+"column" is a Column.
+"unit" is the unit's index.
+
+Precondition: unit must be less than numUnits().
+Postcondition: Returns an int. */
+int CharacterTable::stat(Column column, int unit) const
+{
+   return columns_[column][unit];
+}
+
+/** Returns a pointer to the start of one weapon column, numWeapons()
+long.
+
+"column" is a WeaponColumn.
+
+Precondition: None.
+Postcondition: Returns a const int32_t pointer. */
+const int32_t* CharacterTable::weaponColumn(WeaponColumn column) const
+{
+   return weaponColumns_[column].data();
+}
+
+/** Returns one weapon's value in a weapon column.
+
+"column" is a WeaponColumn.
+"weapon" is the weapon's index.
+
+Precondition: weapon must be less than numWeapons().
+Postcondition: Returns an int. */
+int CharacterTable::weaponStat(WeaponColumn column, int weapon) const
+{
+   return weaponColumns_[column][weapon];
+}
+
+/** Returns the index of a unit's first weapon.
+
+"unit" is the unit's index.
+
+Precondition: unit must be less than numUnits().
+Postcondition: Returns an int. */
+int CharacterTable::weaponBegin(int unit) const
+{
+   return weaponStart_[unit];
+}
+
+/** Returns one past the index of a unit's last weapon.
+
+"unit" is the unit's index.
+
+Precondition: unit must be less than numUnits().
+Postcondition: Returns an int. */
+int CharacterTable::weaponEnd(int unit) const
+{
+   return weaponStart_[unit + 1];
+}
+
+/** Returns a unit's name.
+
+"unit" is the unit's index.
+
+Precondition: unit must be less than numUnits().
+Postcondition: Returns a const string reference. */
+const string& CharacterTable::getName(int unit) const
+{
+   return names_[unit];
+}
+
+/** Returns a weapon's name.
+
+"weapon" is the weapon's index.
+
+Precondition: weapon must be less than numWeapons().
+Postcondition: Returns a const string reference. */
+const string& CharacterTable::getWeaponName(int weapon) const
+{
+   return weaponNames_[weapon];
+}
+
+/** Returns the Character a unit was built from.
+
+"unit" is the unit's index.
+
+Precondition: unit must be less than numUnits(), and the Army must
+still exist.
+Postcondition: Returns a Character pointer. */
+Character* CharacterTable::getCharacter(int unit) const
+{
+   return units_[unit];
+}
+
+/** Builds the CombatProfile for one unit attacking another with one of
+its weapons, exactly as Character::rangedProfile or
+Character::meleeProfile would.
+
+"attacker" is the attacking unit's index.
+"weapon" is the index of one of the attacker's weapons.
+"defenders" is the table holding the defender, which may be this one.
+"defender" is the defending unit's index in that table.
+"defenderWounds" is the defender's remaining wounds.
+
+Precondition: All indices must be in range.
+Postcondition: Returns a CombatProfile. */
+CombatProfile CharacterTable::profile(int attacker, int weapon,
+   const CharacterTable& defenders, int defender, int defenderWounds) const
+{
+   Column hitColumn = weaponColumns_[WEAPON_MELEE][weapon] ? WS : BS;
+
+   return { columns_[hitColumn][attacker], columns_[A][attacker],
+      weaponColumns_[WEAPON_S][weapon], weaponColumns_[WEAPON_AP][weapon],
+      weaponColumns_[WEAPON_D][weapon], defenders.columns_[T][defender],
+      defenders.columns_[SV][defender], defenders.columns_[INV][defender],
+      defenderWounds };
+}
@@ -0,0 +1,158 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Packed structure-of-arrays copy of an Army for batch simulation. Each
+combat characteristic (WS, BS, S, T, W, A, Sv, Inv) is stored as its own
+contiguous column of 32-bit integers, one entry per unit, so a kernel
+sweeping thousands of units reads memory in a straight line instead of
+chasing Node and weapon pointers. The columns are as wide as the
+characteristics themselves, so a unit given an effectively endless
+number of wounds, attacks or damage keeps it in the table.
+
+Weapons are flattened the same way. Unit i owns weapons
+weaponBegin(i) through weaponEnd(i) - 1, ranged first, then melee. */
+
+#include "Army.h"
+#include "Character.h"
+#include "CombatProfile.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+class CharacterTable
+{
+public:
+   /** Per-unit columns. */
+   enum Column { WS, BS, S, T, W, A, SV, INV, NUM_COLUMNS };
+
+   /** Per-weapon columns. WEAPON_MELEE is 1 for melee weapons and 0 for
+   ranged ones. */
+   enum WeaponColumn { WEAPON_S, WEAPON_AP, WEAPON_D, WEAPON_SHOTS, WEAPON_MELEE,
+      NUM_WEAPON_COLUMNS };
+
+private:
+   vector<int32_t> columns_[NUM_COLUMNS];
+   vector<int32_t> weaponColumns_[NUM_WEAPON_COLUMNS];
+   vector<int> weaponStart_; //Size numUnits() + 1
+
+   vector<string> names_;
+   vector<string> weaponNames_;
+   vector<Character*> units_;
+
+public:
+   /** Builds the table from every Character in an Army, in name order.
+
+   "army" is the Army to copy.
+
+   Precondition: None.
+   Postcondition: Creates a CharacterTable. The Army is not modified, and
+   later changes to it are not reflected in the table. */
+   CharacterTable(const Army& army);
+
+   /** Returns the number of units.
+
+   Precondition: None.
+   Postcondition: Returns an int. */
+   int numUnits() const;
+
+   /** Returns the total number of weapons across all units.
+
+   Precondition: None.
+   Postcondition: Returns an int. */
+   int numWeapons() const;
+
+   /** Returns a pointer to the start of one column, numUnits() long.
+
+   "column" is a Column.
+
+   Precondition: None.
+   Postcondition: Returns a const int32_t pointer. */
+   const int32_t* column(Column column) const;
+
+   /** Returns one unit's value in a column.
+
+   "column" is a Column.
+   "unit" is the unit's index.
+
+   Precondition: unit must be less than numUnits().
+   Postcondition: Returns an int. */
+   int stat(Column column, int unit) const;
+
+   /** Returns a pointer to the start of one weapon column, numWeapons()
+   long.
+
+   "column" is a WeaponColumn.
+
+   Precondition: None.
+   Postcondition: Returns a const int32_t pointer. */
+   const int32_t* weaponColumn(WeaponColumn column) const;
+
+   /** Returns one weapon's value in a weapon column.
+
+   "column" is a WeaponColumn.
+   "weapon" is the weapon's index.
+
+   Precondition: weapon must be less than numWeapons().
+   Postcondition: Returns an int. */
+   int weaponStat(WeaponColumn column, int weapon) const;
+
+   /** Returns the index of a unit's first weapon.
+
+   "unit" is the unit's index.
+
+   Precondition: unit must be less than numUnits().
+   Postcondition: Returns an int. */
+   int weaponBegin(int unit) const;
+
+   /** Returns one past the index of a unit's last weapon.
+
+   "unit" is the unit's index.
+
+   Precondition: unit must be less than numUnits().
+   Postcondition: Returns an int. */
+   int weaponEnd(int unit) const;
+
+   /** Returns a unit's name.
+
+   "unit" is the unit's index.
+
+   Precondition: unit must be less than numUnits().
+   Postcondition: Returns a const string reference. */
+   const string& getName(int unit) const;
+
+   /** Returns a weapon's name.
+
+   "weapon" is the weapon's index.
+
+   Precondition: weapon must be less than numWeapons().
+   Postcondition: Returns a const string reference. */
+   const string& getWeaponName(int weapon) const;
+
+   /** Returns the Character a unit was built from.
+
+   "unit" is the unit's index.
+
+   Precondition: unit must be less than numUnits(), and the Army must
+   still exist.
+   Postcondition: Returns a Character pointer. */
+   Character* getCharacter(int unit) const;
+
+   /** Builds the CombatProfile for one unit attacking another with one of
+   its weapons, exactly as Character::rangedProfile or
+   Character::meleeProfile would.
+
+   "attacker" is the attacking unit's index.
+   "weapon" is the index of one of the attacker's weapons.
+   "defenders" is the table holding the defender, which may be this one.
+   "defender" is the defending unit's index in that table.
+   "defenderWounds" is the defender's remaining wounds.
+
+   Precondition: All indices must be in range.
+   Postcondition: Returns a CombatProfile. */
+   CombatProfile profile(int attacker, int weapon, const CharacterTable& defenders,
+      int defender, int defenderWounds) const;
+};
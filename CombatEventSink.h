@@ -0,0 +1,103 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+General parent class for everything that listens to the events of a
+fight in Character::combat. The fight logic reports what happens, and
+the sink decides what, if anything, to do with it: print it, record it,
+or ignore it.
+
+A fight reports, in order: fightStarted, then for each of the hit, wound
+and save stages a stageStarted, a dieRolled per die (only in DIE_BY_DIE
+mode, and only if wantsRolls() is true) or a stageDrawn (only in
+BINOMIAL mode), and a stageFinished, and finally fightFinished. A fight that can't happen reports fightSkipped
+instead. */
+
+#include <string>
+
+using namespace std;
+
+/** The three stages of rolls in a fight. */
+enum CombatStage { HIT_STAGE, WOUND_STAGE, SAVE_STAGE };
+
+class CombatEventSink
+{
+public:
+   /** Virtual destructor so subclasses are cleaned up correctly. */
+   virtual ~CombatEventSink() {}
+
+   /** Returns whether the sink wants every individual die. Returning
+   false lets combat skip the per-die calls entirely.
+
+   Precondition: None.
+   Postcondition: Returns a bool. */
+   virtual bool wantsRolls() const = 0;
+
+   /** The fight didn't happen because one side has no wounds left.
+
+   "attackerDead" is true if the attacker is dead, false if the
+   defender is.
+
+   Precondition: None.
+   Postcondition: None. */
+   virtual void fightSkipped(bool attackerDead) = 0;
+
+   /** The fight is starting.
+
+   "stat" is "WS" or "BS".
+   "hitStat" is the attacker's value of that characteristic.
+   "damage" is the damage of each unsaved wound.
+
+   Precondition: None.
+   Postcondition: None. */
+   virtual void fightStarted(const string& stat, int hitStat, int damage) = 0;
+
+   /** A stage of rolls is starting.
+
+   "stage" is the CombatStage.
+   "threshold" is the roll needed to hit or wound, or the save rolled
+   against.
+
+   Precondition: None.
+   Postcondition: None. */
+   virtual void stageStarted(CombatStage stage, int threshold) = 0;
+
+   /** A single die was rolled.
+
+   "stage" is the CombatStage it belongs to.
+   "roll" is the result, 1-6.
+
+   Precondition: None.
+   Postcondition: None. */
+   virtual void dieRolled(CombatStage stage, int roll) = 0;
+
+   /** The stage's successes were drawn in BINOMIAL mode, so no dice
+   are reported for it.
+
+   "stage" is the CombatStage.
+   "count" is the number of dice the successes were drawn from.
+
+   Precondition: None.
+   Postcondition: None. */
+   virtual void stageDrawn(CombatStage stage, int count) = 0;
+
+   /** A stage of rolls is done.
+
+   "stage" is the CombatStage.
+   "result" is the number of hits, the number of wounds, or for the
+   save stage the number of failed saves.
+
+   Precondition: None.
+   Postcondition: None. */
+   virtual void stageFinished(CombatStage stage, int result) = 0;
+
+   /** The fight is over.
+
+   "damage" is the total damage done.
+   "woundsLeft" is the defender's remaining wounds.
+
+   Precondition: None.
+   Postcondition: None. */
+   virtual void fightFinished(int damage, int woundsLeft) = 0;
+};
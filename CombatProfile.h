@@ -0,0 +1,23 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Snapshot of everything that affects the outcome of one attack between
+two Characters: the attacker's hit characteristic and number of attacks,
+the weapon's S, AP and D, and the defender's T, saves and remaining
+wounds. Engines that run many trials work from a CombatProfile so that
+the Characters themselves are never modified. */
+
+struct CombatProfile
+{
+   int hitStat;        //WS or BS, depending on the type of combat
+   int attacks;        //Number of dice rolled to hit
+   int strength;       //Strength of the weapon
+   int ap;             //Armor piercing value of the weapon
+   int damage;         //Damage of each unsaved wound
+   int toughness;      //Defender's toughness
+   int armorSave;      //Defender's armor save
+   int invulnSave;     //Defender's invuln save, 0 if none
+   int defenderWounds; //Defender's remaining wounds
+};
@@ -0,0 +1,163 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Dice thresholds shared by every combat path in Warhammer-Simulator.
+Character::combat, the Monte Carlo engine, and any other evaluator
+must resolve wound and save rolls through these functions so that all
+of them play by identical rules.
+
+The wound and save rules are precomputed into constexpr tables, so for
+the usual range of characteristics each threshold is a single indexed
+load. */
+
+#include <cstdint>
+
+using namespace std;
+
+/** How a stage of rolls is resolved. DIE_BY_DIE rolls every die, which
+is needed whenever the individual results are shown. BINOMIAL draws the
+number of successes straight from a binomial distribution, which costs
+the same however many dice are in the pool. */
+enum SamplingMode { DIE_BY_DIE, BINOMIAL };
+
+//Characteristics covered by the lookup tables below. Anything outside
+//these ranges falls back to working the rule out directly.
+const int MAX_TABLE_CHARACTERISTIC = 20; //S and T
+const int MAX_TABLE_SAVE = 7;            //Sv and Inv
+const int MAX_TABLE_AP = 6;
+
+/** Works out the roll needed on a d6 to wound from the rules, comparing
+the strength of the weapon against the toughness of the target.
+
+"strength" is the strength of the weapon as an int.
+"toughness" is the toughness of the defender as an int.
+
+Precondition: None.
+Postcondition: Returns an int between 2 and 6. */
+constexpr int computeWoundRoll(int strength, int toughness)
+{
+   if (strength / 2 >= toughness) {
+      return 2;
+   }
+   else if (strength > toughness) {
+      return 3;
+   }
+   else if (strength == toughness) {
+      return 4;
+   }
+   else if (toughness / 2 >= strength) {
+      return 6;
+   }
+   return 5;
+}
+
+/** Works out the save the defender rolls against from the rules, which
+is whichever is higher of the armor save modified by the weapon's AP and
+the invuln save.
+
+"armorSave" is the defender's armor save as an int.
+"invulnSave" is the defender's invuln save, or 0 if it has none.
+"ap" is the armor piercing value of the weapon.
+
+Precondition: None.
+Postcondition: Returns an int. */
+constexpr int computeBestSave(int armorSave, int invulnSave, int ap)
+{
+   return ((armorSave - ap) >= invulnSave) ? (armorSave - ap) : invulnSave;
+}
+
+/** Wound roll for every S x T pair, filled in at compile time. */
+struct WoundRollTable
+{
+   int8_t rolls[MAX_TABLE_CHARACTERISTIC + 1][MAX_TABLE_CHARACTERISTIC + 1];
+
+   constexpr WoundRollTable() : rolls()
+   {
+      for (int s = 0; s <= MAX_TABLE_CHARACTERISTIC; s++) {
+         for (int t = 0; t <= MAX_TABLE_CHARACTERISTIC; t++) {
+            rolls[s][t] = (int8_t)computeWoundRoll(s, t);
+         }
+      }
+   }
+};
+
+/** Save roll for every Sv x Inv x AP combination, filled in at compile
+time. */
+struct SaveRollTable
+{
+   int8_t rolls[MAX_TABLE_SAVE + 1][MAX_TABLE_SAVE + 1][MAX_TABLE_AP + 1];
+
+   constexpr SaveRollTable() : rolls()
+   {
+      for (int sv = 0; sv <= MAX_TABLE_SAVE; sv++) {
+         for (int inv = 0; inv <= MAX_TABLE_SAVE; inv++) {
+            for (int ap = 0; ap <= MAX_TABLE_AP; ap++) {
+               rolls[sv][inv][ap] = (int8_t)computeBestSave(sv, inv, ap);
+            }
+         }
+      }
+   }
+};
+
+inline constexpr WoundRollTable WOUND_TABLE{};
+inline constexpr SaveRollTable SAVE_TABLE{};
+
+/** Returns the roll needed on a d6 to wound, comparing the strength of
+the weapon against the toughness of the target. A single table lookup
+for any S and T up to MAX_TABLE_CHARACTERISTIC.
+
+"strength" is the strength of the weapon as an int.
+"toughness" is the toughness of the defender as an int.
+
+Precondition: None.
+Postcondition: Returns an int between 2 and 6. */
+constexpr int woundRoll(int strength, int toughness)
+{
+   if (unsigned(strength) <= unsigned(MAX_TABLE_CHARACTERISTIC)
+      && unsigned(toughness) <= unsigned(MAX_TABLE_CHARACTERISTIC)) {
+      return WOUND_TABLE.rolls[strength][toughness];
+   }
+   return computeWoundRoll(strength, toughness);
+}
+
+/** Returns the save the defender rolls against, which is whichever is
+higher of the armor save modified by the weapon's AP and the invuln save.
+A single table lookup for the usual ranges of Sv, Inv and AP.
+
+"armorSave" is the defender's armor save as an int.
+"invulnSave" is the defender's invuln save, or 0 if it has none.
+"ap" is the armor piercing value of the weapon.
+
+Precondition: None.
+Postcondition: Returns an int. A roll lower than this value fails the
+save. */
+constexpr int bestSave(int armorSave, int invulnSave, int ap)
+{
+   if (unsigned(armorSave) <= unsigned(MAX_TABLE_SAVE)
+      && unsigned(invulnSave) <= unsigned(MAX_TABLE_SAVE)
+      && unsigned(ap) <= unsigned(MAX_TABLE_AP)) {
+      return SAVE_TABLE.rolls[armorSave][invulnSave][ap];
+   }
+   return computeBestSave(armorSave, invulnSave, ap);
+}
+
+static_assert(woundRoll(8, 4) == 2 && woundRoll(5, 4) == 3 && woundRoll(4, 4) == 4
+   && woundRoll(3, 4) == 5 && woundRoll(2, 4) == 6, "Wound table out of step with rules");
+static_assert(bestSave(3, 5, 1) == 5 && bestSave(6, 4, 1) == 5 && bestSave(3, 0, 0) == 3,
+   "Save table out of step with rules");
+
+/** Returns the chance that a single d6 rolls the given value or higher.
+
+"target" is the roll needed, as an int.
+
+Precondition: None.
+Postcondition: Returns a double between 0 and 1. Targets of 1 or less
+always succeed and targets above 6 never do. */
+constexpr double chanceAtLeast(int target)
+{
+   if (target <= 1) return 1.0;
+   if (target > 6) return 0.0;
+   return (7 - target) / 6.0;
+}
@@ -0,0 +1,194 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Opt-in instrumentation for the combat pipeline, kept in per-thread
+counters and summed across threads when read. */
+
+#include "CombatStats.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstddef>
+
+using namespace std;
+
+//CombatCounters is read and written as a flat array of counters.
+const int NUM_FIELDS = sizeof(CombatCounters) / sizeof(long long);
+static_assert(sizeof(CombatCounters) == NUM_FIELDS * sizeof(long long),
+   "CombatCounters must hold only long longs");
+
+/** Index of a CombatCounters field in the flat array. */
+#define FIELD(name) (int)(offsetof(CombatCounters, name) / sizeof(long long))
+
+/** One thread's counters. Only the owning thread writes them, but any
+thread may read them, so they are relaxed atomics. */
+struct ThreadCounters
+{
+   atomic<long long> values[NUM_FIELDS];
+
+   ThreadCounters();
+   ~ThreadCounters();
+
+   void add(int field, long long amount)
+   {
+      values[field].store(values[field].load(memory_order_relaxed) + amount,
+         memory_order_relaxed);
+   }
+};
+
+static atomic<bool> recording(false);
+static mutex registryLock;
+static vector<ThreadCounters*> liveThreads;
+static long long retired[NUM_FIELDS]; //Counts of threads that have exited
+static thread_local ThreadCounters counters;
+
+ThreadCounters::ThreadCounters()
+{
+   for (int i = 0; i < NUM_FIELDS; i++) values[i] = 0;
+
+   lock_guard<mutex> guard(registryLock);
+   liveThreads.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters()
+{
+   lock_guard<mutex> guard(registryLock);
+   for (int i = 0; i < NUM_FIELDS; i++) retired[i] += values[i].load();
+   liveThreads.erase(find(liveThreads.begin(), liveThreads.end(), this));
+}
+
+/** Turns recording on or off for every thread. Off by default.
+
+"on" is whether to record.
+
+Precondition: None.
+Postcondition: Later fights are recorded if on is true. */
+void CombatStats::enable(bool on)
+{
+   recording.store(on, memory_order_relaxed);
+}
+
+/** Returns whether recording is on.
+
+Precondition: None.
+Postcondition: Returns a bool. */
+bool CombatStats::enabled()
+{
+   return recording.load(memory_order_relaxed);
+}
+
+/** Returns a monotonic clock reading for the timers.
+
+Precondition: None.
+Postcondition: Returns nanoseconds as a long long. */
+long long CombatStats::now()
+{
+   return chrono::duration_cast<chrono::nanoseconds>(
+      chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** Records one stage of a fight on this thread.
+
+"stage" is the CombatStage.
+"dice" is the number of dice in the stage.
+"successes" is the stage's result.
+"drawn" is whether the successes were drawn in BINOMIAL mode rather
+than rolled die by die.
+"rollNanos" is the time spent rolling and counting, or drawing.
+"reportNanos" is the time spent reporting dice to the sink.
+
+Precondition: None.
+Postcondition: The stage is added to this thread's counters, its
+dice under drawnDice if drawn and under dice otherwise. */
+void CombatStats::addStage(CombatStage stage, int dice, int successes, bool drawn,
+   long long rollNanos, long long reportNanos)
+{
+   counters.add((drawn ? FIELD(drawnDice) : FIELD(dice)) + stage, dice);
+   counters.add(FIELD(successes) + stage, successes);
+   counters.add(FIELD(rollNanos) + stage, rollNanos);
+   counters.add(FIELD(reportNanos) + stage, reportNanos);
+}
+
+/** Records one finished fight on this thread.
+
+"damage" is the damage dealt.
+"nanos" is the time the whole fight took.
+
+Precondition: None.
+Postcondition: The fight is added to this thread's counters. */
+void CombatStats::addFight(int damage, long long nanos)
+{
+   counters.add(FIELD(fights), 1);
+   counters.add(FIELD(damage), damage);
+   counters.add(FIELD(fightNanos), nanos);
+}
+
+/** Records one Combat::fight dispatch on this thread.
+
+"nanos" is the time the dispatch took.
+
+Precondition: None.
+Postcondition: The dispatch is added to this thread's counters. */
+void CombatStats::addDispatch(long long nanos)
+{
+   counters.add(FIELD(dispatches), 1);
+   counters.add(FIELD(dispatchNanos), nanos);
+}
+
+/** Returns the counters summed across every thread, including threads
+that have since exited.
+
+Precondition: None.
+Postcondition: Returns a CombatCounters. */
+CombatCounters CombatStats::total()
+{
+   long long sums[NUM_FIELDS];
+
+   lock_guard<mutex> guard(registryLock);
+   for (int i = 0; i < NUM_FIELDS; i++) sums[i] = retired[i];
+   for (ThreadCounters* thread : liveThreads) {
+      for (int i = 0; i < NUM_FIELDS; i++) {
+         sums[i] += thread->values[i].load(memory_order_relaxed);
+      }
+   }
+
+   CombatCounters result;
+   memcpy(&result, sums, sizeof(result));
+   return result;
+}
+
+/** Returns the counters of the calling thread only.
+
+Precondition: None.
+Postcondition: Returns a CombatCounters. */
+CombatCounters CombatStats::local()
+{
+   long long values[NUM_FIELDS];
+   for (int i = 0; i < NUM_FIELDS; i++) {
+      values[i] = counters.values[i].load(memory_order_relaxed);
+   }
+
+   CombatCounters result;
+   memcpy(&result, values, sizeof(result));
+   return result;
+}
+
+/** Zeroes every thread's counters.
+
+Precondition: Should be called while no fights are running, or counts
+from fights in progress may be lost.
+Postcondition: Every counter is 0. */
+void CombatStats::reset()
+{
+   lock_guard<mutex> guard(registryLock);
+   for (int i = 0; i < NUM_FIELDS; i++) retired[i] = 0;
+   for (ThreadCounters* thread : liveThreads) {
+      for (int i = 0; i < NUM_FIELDS; i++) {
+         thread->values[i].store(0, memory_order_relaxed);
+      }
+   }
+}
@@ -0,0 +1,119 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Opt-in instrumentation for the combat pipeline. While enabled, every
+Character::combat counts the dice it rolls, its hits, wounds, failed
+saves and damage, and times each stage, split into rolling the dice and
+reporting them to the event sink. Each Combat::fight dispatch is timed
+as well.
+
+Counters are kept per thread, so recording never contends with other
+threads, and are summed across threads when read. While disabled, the
+pipeline pays for a single flag check per fight.
+
+Only fights that go through Character::combat are recorded, i.e.
+interactive fights and anything else driving Characters directly. The
+batch engines (MonteCarlo, ParallelMonteCarlo, BattleSimulator and the
+kernels under them) resolve attacks from CombatProfiles without a
+Character, and are not counted; time those with Benchmark instead. */
+
+#include "CombatEventSink.h"
+#include <cstdint>
+
+using namespace std;
+
+const int NUM_PHASES = 3; //One per CombatStage
+
+/** A snapshot of the counters. Phase arrays are indexed by CombatStage. */
+struct CombatCounters
+{
+   long long fights;                  //Fights that went ahead
+   long long dice[NUM_PHASES];        //Dice rolled one by one
+   long long drawnDice[NUM_PHASES];   //Dice resolved by a binomial draw, never rolled
+   long long successes[NUM_PHASES];   //Hits, wounds and failed saves
+   long long damage;                  //Total damage dealt
+   long long rollNanos[NUM_PHASES];   //Rolling and counting the dice
+   long long reportNanos[NUM_PHASES]; //Reporting individual dice to the sink
+   long long fightNanos;              //Whole of Character::combat
+   long long dispatches;              //Combat::fight calls
+   long long dispatchNanos;           //Time inside Combat::fight
+};
+
+class CombatStats
+{
+public:
+   /** Turns recording on or off for every thread. Off by default.
+
+   "on" is whether to record.
+
+   Precondition: None.
+   Postcondition: Later fights are recorded if on is true. */
+   static void enable(bool on);
+
+   /** Returns whether recording is on.
+
+   Precondition: None.
+   Postcondition: Returns a bool. */
+   static bool enabled();
+
+   /** Returns a monotonic clock reading for the timers.
+
+   Precondition: None.
+   Postcondition: Returns nanoseconds as a long long. */
+   static long long now();
+
+   /** Records one stage of a fight on this thread.
+
+   "stage" is the CombatStage.
+   "dice" is the number of dice in the stage.
+   "successes" is the stage's result.
+   "drawn" is whether the successes were drawn in BINOMIAL mode rather
+   than rolled die by die.
+   "rollNanos" is the time spent rolling and counting, or drawing.
+   "reportNanos" is the time spent reporting dice to the sink.
+
+   Precondition: None.
+   Postcondition: The stage is added to this thread's counters, its
+   dice under drawnDice if drawn and under dice otherwise. */
+   static void addStage(CombatStage stage, int dice, int successes, bool drawn,
+      long long rollNanos, long long reportNanos);
+
+   /** Records one finished fight on this thread.
+
+   "damage" is the damage dealt.
+   "nanos" is the time the whole fight took.
+
+   Precondition: None.
+   Postcondition: The fight is added to this thread's counters. */
+   static void addFight(int damage, long long nanos);
+
+   /** Records one Combat::fight dispatch on this thread.
+
+   "nanos" is the time the dispatch took.
+
+   Precondition: None.
+   Postcondition: The dispatch is added to this thread's counters. */
+   static void addDispatch(long long nanos);
+
+   /** Returns the counters summed across every thread, including threads
+   that have since exited.
+
+   Precondition: None.
+   Postcondition: Returns a CombatCounters. */
+   static CombatCounters total();
+
+   /** Returns the counters of the calling thread only.
+
+   Precondition: None.
+   Postcondition: Returns a CombatCounters. */
+   static CombatCounters local();
+
+   /** Zeroes every thread's counters.
+
+   Precondition: Should be called while no fights are running, or counts
+   from fights in progress may be lost.
+   Postcondition: Every counter is 0. */
+   static void reset();
+};
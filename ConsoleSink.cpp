@@ -0,0 +1,90 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Inherits the CombatEventSink class, and prints every event of a fight
+to an output stream in the same format Character::combat always has. */
+
+#include "ConsoleSink.h"
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+/** Constructor that prints to the given stream.
+
+"os" is the output stream, cout by default.
+
+Precondition: The stream must outlive the sink.
+Postcondition: Creates a ConsoleSink. */
+ConsoleSink::ConsoleSink(ostream& os) : os_(os), damage_(0)
+{
+}
+
+/** Returns true, since every die is printed. */
+bool ConsoleSink::wantsRolls() const
+{
+   return true;
+}
+
+/** Prints which side is already dead. */
+void ConsoleSink::fightSkipped(bool attackerDead)
+{
+   if (attackerDead) {
+      os_ << "Attacking character is already dead...";
+   }
+   else {
+      os_ << "Enemy character is already dead...";
+   }
+}
+
+/** Prints the characteristic being rolled to hit with. */
+void ConsoleSink::fightStarted(const string& stat, int hitStat, int damage)
+{
+   damage_ = damage;
+   os_ << "Rolling to hit with " << stat << " " << hitStat << "..." << endl;
+}
+
+/** Prints the roll needed for the wound and save stages. */
+void ConsoleSink::stageStarted(CombatStage stage, int threshold)
+{
+   if (stage == WOUND_STAGE) {
+      os_ << "Wounding on " << threshold << "s.." << endl;
+   }
+   else if (stage == SAVE_STAGE) {
+      os_ << "Each hit does " << to_string(damage_) << " damage." << endl;
+      os_ << "Saving on " << threshold << "s." << endl;
+   }
+}
+
+/** Prints a single die. */
+void ConsoleSink::dieRolled(CombatStage /*stage*/, int roll)
+{
+   os_ << roll << " ";
+}
+
+/** Prints nothing, since only the stage's total is known. */
+void ConsoleSink::stageDrawn(CombatStage /*stage*/, int /*count*/)
+{
+}
+
+/** Prints the stage's total. */
+void ConsoleSink::stageFinished(CombatStage stage, int result)
+{
+   if (stage == HIT_STAGE) {
+      os_ << endl << "Total number of hits: " << result << endl;
+   }
+   else if (stage == WOUND_STAGE) {
+      os_ << endl << "Total wounds: " << result << endl;
+   }
+   else {
+      os_ << endl << result << " succesful wounds." << endl;
+   }
+}
+
+/** Prints the damage done and the target's remaining wounds. */
+void ConsoleSink::fightFinished(int damage, int woundsLeft)
+{
+   os_ << damage << " damage done!" << endl;
+   os_ << "Target has " << woundsLeft << " health left!";
+}
@@ -0,0 +1,53 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Inherits the CombatEventSink class, and prints every event of a fight
+to an output stream in the same format Character::combat always has. */
+
+#include "CombatEventSink.h"
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+class ConsoleSink : public CombatEventSink
+{
+private:
+   ostream& os_;
+   int damage_; //Damage per wound of the current fight
+
+public:
+   /** Constructor that prints to the given stream.
+
+   "os" is the output stream, cout by default.
+
+   Precondition: The stream must outlive the sink.
+   Postcondition: Creates a ConsoleSink. */
+   ConsoleSink(ostream& os = cout);
+
+   /** Returns true, since every die is printed. */
+   virtual bool wantsRolls() const;
+
+   /** Prints which side is already dead. */
+   virtual void fightSkipped(bool attackerDead);
+
+   /** Prints the characteristic being rolled to hit with. */
+   virtual void fightStarted(const string& stat, int hitStat, int damage);
+
+   /** Prints the roll needed for the wound and save stages. */
+   virtual void stageStarted(CombatStage stage, int threshold);
+
+   /** Prints a single die. */
+   virtual void dieRolled(CombatStage stage, int roll);
+
+   /** Prints nothing, since only the stage's total is known. */
+   virtual void stageDrawn(CombatStage stage, int count);
+
+   /** Prints the stage's total. */
+   virtual void stageFinished(CombatStage stage, int result);
+
+   /** Prints the damage done and the target's remaining wounds. */
+   virtual void fightFinished(int damage, int woundsLeft);
+};
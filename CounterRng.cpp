@@ -0,0 +1,135 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Counter-based random number generator (Philox4x32-10). Every output is
+a pure function of (seed, stream, position), so there is no hidden state
+to carry between calls.
+
+Round function and constants from Salmon et al., "Parallel Random
+Numbers: As Easy as 1, 2, 3" (SC11). */
+
+#include "CounterRng.h"
+#include <cstdint>
+
+using namespace std;
+
+const uint32_t PHILOX_M0 = 0xD2511F53u;
+const uint32_t PHILOX_M1 = 0xCD9E8D57u;
+const uint32_t PHILOX_W0 = 0x9E3779B9u;
+const uint32_t PHILOX_W1 = 0xBB67AE85u;
+const int PHILOX_ROUNDS = 10;
+
+/** Constructor for a given seed and stream.
+
+"seed" is a 64-bit seed.
+"stream" selects an independent sequence under that seed, for example
+a trial index.
+
+Precondition: None.
+Postcondition: Creates a CounterRng at the start of the stream. */
+CounterRng::CounterRng(uint64_t seed, uint64_t stream)
+{
+   this->seed(seed, stream);
+}
+
+/** Restarts the generator on the given seed and stream.
+
+"seed" is a 64-bit seed.
+"stream" selects an independent sequence under that seed.
+
+Precondition: None.
+Postcondition: The next output is the first of that stream. */
+void CounterRng::seed(uint64_t seed, uint64_t stream)
+{
+   key_[0] = (uint32_t)seed;
+   key_[1] = (uint32_t)(seed >> 32);
+   counter_[0] = 0;
+   counter_[1] = 0;
+   counter_[2] = (uint32_t)stream;
+   counter_[3] = (uint32_t)(stream >> 32);
+   used_ = 4;
+}
+
+/** Skips ahead within the current stream.
+
+"words" is the number of 32-bit outputs to skip.
+
+Precondition: None.
+Postcondition: The generator is positioned as if operator() had been
+called that many more times. */
+void CounterRng::discard(uint64_t words)
+{
+   uint64_t inBlock = 4 - used_;
+   if (words < inBlock) {
+      used_ += (int)words;
+      return;
+   }
+   words -= inBlock;
+
+   //counter_ already points past the current block.
+   uint64_t position = ((uint64_t)counter_[1] << 32 | counter_[0]) + words / 4;
+   counter_[0] = (uint32_t)position;
+   counter_[1] = (uint32_t)(position >> 32);
+   used_ = 4;
+
+   if (words % 4 != 0) {
+      generateBlock();
+      used_ = (int)(words % 4);
+   }
+}
+
+/** Encrypts the current counter under the key into block_.
+
+Precondition: None.
+Postcondition: block_ holds four fresh random words. */
+void CounterRng::generateBlock()
+{
+   uint32_t c0 = counter_[0], c1 = counter_[1], c2 = counter_[2], c3 = counter_[3];
+   uint32_t k0 = key_[0], k1 = key_[1];
+
+   for (int round = 0; round < PHILOX_ROUNDS; round++) {
+      uint64_t product0 = (uint64_t)PHILOX_M0 * c0;
+      uint64_t product1 = (uint64_t)PHILOX_M1 * c2;
+
+      uint32_t next0 = (uint32_t)(product1 >> 32) ^ c1 ^ k0;
+      uint32_t next2 = (uint32_t)(product0 >> 32) ^ c3 ^ k1;
+      c1 = (uint32_t)product1;
+      c3 = (uint32_t)product0;
+      c0 = next0;
+      c2 = next2;
+
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+   }
+
+   block_[0] = c0;
+   block_[1] = c1;
+   block_[2] = c2;
+   block_[3] = c3;
+   used_ = 0;
+
+   //Advance the 64-bit block position for the next call.
+   if (++counter_[0] == 0) counter_[1]++;
+}
+
+/** Returns the next 32-bit random word.
+
+Precondition: None.
+Postcondition: Returns a uniformly distributed uint32_t. */
+CounterRng::result_type CounterRng::operator()()
+{
+   if (used_ == 4) generateBlock();
+   return block_[used_++];
+}
+
+/** Returns the next 64-bit random word, made of two 32-bit outputs.
+
+Precondition: None.
+Postcondition: Returns a uniformly distributed uint64_t. */
+uint64_t CounterRng::next64()
+{
+   uint64_t low = (*this)();
+   uint64_t high = (*this)();
+   return (high << 32) | low;
+}
@@ -0,0 +1,81 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Counter-based random number generator (Philox4x32-10). Every output is
+a pure function of (seed, stream, position), so there is no hidden state
+to carry between calls: seeding a generator with a trial's index gives
+that trial the same rolls no matter which thread runs it or in what
+order, and any trial can be jumped to directly.
+
+Meets the requirements of a uniform random bit generator, so it can be
+passed to the distributions in <random>. */
+
+#include <cstdint>
+
+using namespace std;
+
+class CounterRng
+{
+private:
+   uint32_t key_[2];     //From the seed
+   uint32_t counter_[4]; //Block position and stream
+   uint32_t block_[4];   //Output of the current block
+   int used_;            //Words of block_ already handed out
+
+   /** Encrypts the current counter under the key into block_.
+
+   Precondition: None.
+   Postcondition: block_ holds four fresh random words. */
+   void generateBlock();
+
+public:
+   typedef uint32_t result_type;
+
+   /** Constructor for a given seed and stream.
+
+   "seed" is a 64-bit seed.
+   "stream" selects an independent sequence under that seed, for example
+   a trial index.
+
+   Precondition: None.
+   Postcondition: Creates a CounterRng at the start of the stream. */
+   CounterRng(uint64_t seed = 0, uint64_t stream = 0);
+
+   /** Restarts the generator on the given seed and stream.
+
+   "seed" is a 64-bit seed.
+   "stream" selects an independent sequence under that seed.
+
+   Precondition: None.
+   Postcondition: The next output is the first of that stream. */
+   void seed(uint64_t seed, uint64_t stream = 0);
+
+   /** Skips ahead within the current stream.
+
+   "words" is the number of 32-bit outputs to skip.
+
+   Precondition: None.
+   Postcondition: The generator is positioned as if operator() had been
+   called that many more times. */
+   void discard(uint64_t words);
+
+   /** Returns the next 32-bit random word.
+
+   Precondition: None.
+   Postcondition: Returns a uniformly distributed uint32_t. */
+   result_type operator()();
+
+   /** Returns the next 64-bit random word, made of two 32-bit outputs.
+
+   Precondition: None.
+   Postcondition: Returns a uniformly distributed uint64_t. */
+   uint64_t next64();
+
+   /** Smallest value operator() returns. */
+   static constexpr result_type min() { return 0; }
+
+   /** Largest value operator() returns. */
+   static constexpr result_type max() { return 0xFFFFFFFFu; }
+};
@@ -0,0 +1,98 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Exact probability mass function of the damage dealt by an attack.
+Index i holds the probability that exactly i damage is done. This is
+the analytic counterpart of DamageHistogram. */
+
+#include "DamageDistribution.h"
+#include <vector>
+
+using namespace std;
+
+/** Basic constructor. Starts off as a certain 0 damage.
+
+Precondition: None.
+Postcondition: Creates a DamageDistribution. */
+DamageDistribution::DamageDistribution() : pmf_(1, 1.0)
+{
+}
+
+/** Constructor that takes ownership of an existing mass function.
+
+"pmf" is a vector of probabilities indexed by damage.
+
+Precondition: The probabilities should sum to 1.
+Postcondition: Creates a DamageDistribution. */
+DamageDistribution::DamageDistribution(vector<double> pmf) : pmf_(move(pmf))
+{
+   if (pmf_.empty()) pmf_.push_back(1.0);
+}
+
+/** Returns the probability of each damage value, indexed by damage.
+
+Precondition: None.
+Postcondition: Returns a const reference to a vector. */
+const vector<double>& DamageDistribution::probabilities() const
+{
+   return pmf_;
+}
+
+/** Returns the probability that exactly the given damage is done.
+
+"damage" is an int.
+
+Precondition: None.
+Postcondition: Returns a double. Returns 0 for values out of range. */
+double DamageDistribution::probability(int damage) const
+{
+   if (damage < 0 || unsigned(damage) >= pmf_.size()) return 0;
+   return pmf_[damage];
+}
+
+/** Returns the expected damage.
+
+Precondition: None.
+Postcondition: Returns a double. */
+double DamageDistribution::mean() const
+{
+   double total = 0;
+   for (int i = 0; unsigned(i) < pmf_.size(); i++) {
+      total += i * pmf_[i];
+   }
+   return total;
+}
+
+/** Returns the variance of the damage.
+
+Precondition: None.
+Postcondition: Returns a double. */
+double DamageDistribution::variance() const
+{
+   double average = mean();
+   double total = 0;
+   for (int i = 0; unsigned(i) < pmf_.size(); i++) {
+      total += (i - average) * (i - average) * pmf_[i];
+   }
+   return total;
+}
+
+/** Returns the chance of doing at least the given amount of damage,
+i.e. the chance of killing a defender with that many wounds left.
+
+"wounds" is the defender's remaining wounds.
+
+Precondition: None.
+Postcondition: Returns a double between 0 and 1. A defender with no
+wounds left is always killed. */
+double DamageDistribution::killProbability(int wounds) const
+{
+   if (wounds <= 0) return 1;
+
+   double total = 0;
+   for (int i = wounds; unsigned(i) < pmf_.size(); i++) {
+      total += pmf_[i];
+   }
+   return total;
+}
@@ -0,0 +1,69 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Exact probability mass function of the damage dealt by an attack.
+Index i holds the probability that exactly i damage is done. This is
+the analytic counterpart of DamageHistogram. */
+
+#include <vector>
+
+using namespace std;
+
+class DamageDistribution
+{
+private:
+   vector<double> pmf_;
+
+public:
+   /** Basic constructor. Starts off as a certain 0 damage.
+
+   Precondition: None.
+   Postcondition: Creates a DamageDistribution. */
+   DamageDistribution();
+
+   /** Constructor that takes ownership of an existing mass function.
+
+   "pmf" is a vector of probabilities indexed by damage.
+
+   Precondition: The probabilities should sum to 1.
+   Postcondition: Creates a DamageDistribution. */
+   DamageDistribution(vector<double> pmf);
+
+   /** Returns the probability of each damage value, indexed by damage.
+
+   Precondition: None.
+   Postcondition: Returns a const reference to a vector. */
+   const vector<double>& probabilities() const;
+
+   /** Returns the probability that exactly the given damage is done.
+
+   "damage" is an int.
+
+   Precondition: None.
+   Postcondition: Returns a double. Returns 0 for values out of range. */
+   double probability(int damage) const;
+
+   /** Returns the expected damage.
+
+   Precondition: None.
+   Postcondition: Returns a double. */
+   double mean() const;
+
+   /** Returns the variance of the damage.
+
+   Precondition: None.
+   Postcondition: Returns a double. */
+   double variance() const;
+
+   /** Returns the chance of doing at least the given amount of damage,
+   i.e. the chance of killing a defender with that many wounds left.
+
+   "wounds" is the defender's remaining wounds.
+
+   Precondition: None.
+   Postcondition: Returns a double between 0 and 1. A defender with no
+   wounds left is always killed. */
+   double killProbability(int wounds) const;
+};
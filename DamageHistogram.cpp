@@ -0,0 +1,169 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Tally of how much damage was dealt across many simulated attacks.
+Index i of the histogram holds the number of trials in which exactly
+i damage was done. Histograms from separate runs can be merged. */
+
+#include "DamageHistogram.h"
+#include <vector>
+#include <cmath>
+
+using namespace std;
+
+/** Basic constructor. Starts off with no trials recorded.
+
+Precondition: None.
+Postcondition: Creates an empty DamageHistogram. */
+DamageHistogram::DamageHistogram() : trials_(0)
+{
+}
+
+/** Records one trial that dealt the given amount of damage.
+
+"damage" is a non-negative int.
+
+Precondition: damage must not be negative.
+Postcondition: The count for that damage value is incremented. */
+void DamageHistogram::add(int damage)
+{
+   if ((int)counts_.size() <= damage) {
+      counts_.resize(damage + 1, 0);
+   }
+   counts_[damage]++;
+   trials_++;
+}
+
+/** Adds every trial recorded in another histogram to this one.
+
+"other" is another DamageHistogram.
+
+Precondition: None.
+Postcondition: This histogram holds the trials of both. */
+void DamageHistogram::merge(const DamageHistogram& other)
+{
+   if (counts_.size() < other.counts_.size()) {
+      counts_.resize(other.counts_.size(), 0);
+   }
+   for (int i = 0; unsigned(i) < other.counts_.size(); i++) {
+      counts_[i] += other.counts_[i];
+   }
+   trials_ += other.trials_;
+}
+
+/** Returns the number of trials recorded.
+
+Precondition: None.
+Postcondition: Returns a long long. */
+long long DamageHistogram::trials() const
+{
+   return trials_;
+}
+
+/** Returns the raw counts, indexed by damage.
+
+Precondition: None.
+Postcondition: Returns a const reference to a vector. */
+const vector<long long>& DamageHistogram::counts() const
+{
+   return counts_;
+}
+
+/** Returns the mean damage per trial.
+
+Precondition: None.
+Postcondition: Returns a double. Returns 0 if there are no trials. */
+double DamageHistogram::mean() const
+{
+   if (trials_ == 0) return 0;
+
+   double total = 0;
+   for (int i = 0; unsigned(i) < counts_.size(); i++) {
+      total += (double)i * counts_[i];
+   }
+   return total / trials_;
+}
+
+/** Returns the variance of the damage per trial.
+
+Precondition: None.
+Postcondition: Returns a double. Returns 0 if there are no trials. */
+double DamageHistogram::variance() const
+{
+   if (trials_ == 0) return 0;
+
+   double average = mean();
+   double total = 0;
+   for (int i = 0; unsigned(i) < counts_.size(); i++) {
+      total += (i - average) * (i - average) * counts_[i];
+   }
+   return total / trials_;
+}
+
+/** Returns the fraction of trials that did at least the given
+amount of damage, i.e. the chance of killing a defender with that
+many wounds left.
+
+"wounds" is the defender's remaining wounds.
+
+Precondition: None.
+Postcondition: Returns a double between 0 and 1. A defender with no
+wounds left counts as killed in every trial. */
+double DamageHistogram::killProbability(int wounds) const
+{
+   if (trials_ == 0) return 0;
+   if (wounds <= 0) return 1;
+
+   long long kills = 0;
+   for (int i = wounds; unsigned(i) < counts_.size(); i++) {
+      kills += counts_[i];
+   }
+   return (double)kills / trials_;
+}
+
+/** Returns the half-width of a normal confidence interval on the mean
+damage, using the sample variance.
+
+"z" is the z-score of the confidence level, e.g. 1.96 for 95%.
+
+Precondition: None.
+Postcondition: Returns a double. Returns 0 with fewer than two
+trials, and also when every trial did the same damage. */
+double DamageHistogram::meanHalfWidth(double z) const
+{
+   if (trials_ < 2) return 0;
+
+   double sampleVariance = variance() * trials_ / (trials_ - 1);
+   return z * sqrt(sampleVariance / trials_);
+}
+
+/** Works out a Wilson score confidence interval on the kill
+probability. Unlike the normal interval it stays honest when kills
+are rare, never collapsing to zero width just because no kill has
+been seen yet.
+
+"wounds" is the defender's remaining wounds.
+"z" is the z-score of the confidence level, e.g. 1.96 for 95%.
+"lower" and "upper" receive the bounds of the interval.
+
+Precondition: None.
+Postcondition: lower and upper are between 0 and 1. Both are 0 and 1
+respectively if there are no trials. */
+void DamageHistogram::killInterval(int wounds, double z, double& lower, double& upper) const
+{
+   if (trials_ == 0) {
+      lower = 0;
+      upper = 1;
+      return;
+   }
+
+   double n = (double)trials_;
+   double p = killProbability(wounds);
+   double z2 = z * z;
+   double centre = (p + z2 / (2 * n)) / (1 + z2 / n);
+   double spread = z * sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / (1 + z2 / n);
+
+   lower = (centre - spread > 0) ? centre - spread : 0;
+   upper = (centre + spread < 1) ? centre + spread : 1;
+}
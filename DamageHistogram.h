@@ -0,0 +1,101 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Tally of how much damage was dealt across many simulated attacks.
+Index i of the histogram holds the number of trials in which exactly
+i damage was done. Histograms from separate runs can be merged. */
+
+#include <vector>
+
+using namespace std;
+
+class DamageHistogram
+{
+private:
+   vector<long long> counts_;
+   long long trials_;
+
+public:
+   /** Basic constructor. Starts off with no trials recorded.
+
+   Precondition: None.
+   Postcondition: Creates an empty DamageHistogram. */
+   DamageHistogram();
+
+   /** Records one trial that dealt the given amount of damage.
+
+   "damage" is a non-negative int.
+
+   Precondition: damage must not be negative.
+   Postcondition: The count for that damage value is incremented. */
+   void add(int damage);
+
+   /** Adds every trial recorded in another histogram to this one.
+
+   "other" is another DamageHistogram.
+
+   Precondition: None.
+   Postcondition: This histogram holds the trials of both. */
+   void merge(const DamageHistogram& other);
+
+   /** Returns the number of trials recorded.
+
+   Precondition: None.
+   Postcondition: Returns a long long. */
+   long long trials() const;
+
+   /** Returns the raw counts, indexed by damage.
+
+   Precondition: None.
+   Postcondition: Returns a const reference to a vector. */
+   const vector<long long>& counts() const;
+
+   /** Returns the mean damage per trial.
+
+   Precondition: None.
+   Postcondition: Returns a double. Returns 0 if there are no trials. */
+   double mean() const;
+
+   /** Returns the variance of the damage per trial.
+
+   Precondition: None.
+   Postcondition: Returns a double. Returns 0 if there are no trials. */
+   double variance() const;
+
+   /** Returns the fraction of trials that did at least the given
+   amount of damage, i.e. the chance of killing a defender with that
+   many wounds left.
+
+   "wounds" is the defender's remaining wounds.
+
+   Precondition: None.
+   Postcondition: Returns a double between 0 and 1. A defender with no
+   wounds left counts as killed in every trial. */
+   double killProbability(int wounds) const;
+
+   /** Returns the half-width of a normal confidence interval on the mean
+   damage, using the sample variance.
+
+   "z" is the z-score of the confidence level, e.g. 1.96 for 95%.
+
+   Precondition: None.
+   Postcondition: Returns a double. Returns 0 with fewer than two
+   trials, and also when every trial did the same damage. */
+   double meanHalfWidth(double z) const;
+
+   /** Works out a Wilson score confidence interval on the kill
+   probability. Unlike the normal interval it stays honest when kills
+   are rare, never collapsing to zero width just because no kill has
+   been seen yet.
+
+   "wounds" is the defender's remaining wounds.
+   "z" is the z-score of the confidence level, e.g. 1.96 for 95%.
+   "lower" and "upper" receive the bounds of the interval.
+
+   Precondition: None.
+   Postcondition: lower and upper are between 0 and 1. Both are 0 and 1
+   respectively if there are no trials. */
+   void killInterval(int wounds, double z, double& lower, double& upper) const;
+};
@@ -0,0 +1,259 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Inherits the CombatEventSink class, and records every fight into a
+compact, append-only binary journal of 3-bit codes. */
+
+#include "DiceJournal.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+/** Opens a journal file for appending, writing the header if the file
+is new or empty. A file that already holds something other than a
+journal of this version is left alone and not opened.
+
+"fileName" is the journal's path.
+
+Precondition: None.
+Postcondition: Creates a DiceJournal. Check isOpen() for success. */
+DiceJournal::DiceJournal(string fileName) : bits_(0), bitCount_(0), drawnFrom_(-1)
+{
+   file_.open(fileName, ios::binary | ios::app);
+   if (!file_.is_open()) return;
+
+   file_.seekp(0, ios::end);
+   if (file_.tellp() == 0) {
+      uint32_t version = JOURNAL_VERSION;
+      file_.write(JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+      file_.write((const char*)&version, sizeof(version));
+   }
+   else {
+      //Appending this version's codes to anything else would corrupt it.
+      ifstream existing(fileName, ios::binary);
+      char magic[sizeof(JOURNAL_MAGIC)] = {};
+      uint32_t version = 0;
+      existing.read(magic, sizeof(magic));
+      existing.read((char*)&version, sizeof(version));
+      if (!existing || memcmp(magic, JOURNAL_MAGIC, sizeof(magic)) != 0
+         || version != JOURNAL_VERSION) {
+         file_.close();
+         return;
+      }
+   }
+
+   buffer_.reserve(FLUSH_SIZE);
+}
+
+/** Ends the session and closes the file.
+
+Precondition: None.
+Postcondition: Everything recorded is on disk. */
+DiceJournal::~DiceJournal()
+{
+   if (!file_.is_open()) return;
+
+   //End the session and pad the last byte with ones.
+   putCode(JOURNAL_END_CODE);
+   if (bitCount_ > 0) {
+      buffer_.push_back((uint8_t)(bits_ | (0xFFu << bitCount_)));
+      bits_ = 0;
+      bitCount_ = 0;
+   }
+
+   flush();
+   file_.close();
+}
+
+/** Returns whether the file was opened for recording.
+
+Precondition: None.
+Postcondition: Returns a bool. */
+bool DiceJournal::isOpen() const
+{
+   return file_.is_open();
+}
+
+/** Writes out everything buffered so far except a partial byte.
+
+Precondition: None.
+Postcondition: Whole bytes are passed to the file. */
+void DiceJournal::flush()
+{
+   if (!buffer_.empty()) {
+      file_.write((const char*)buffer_.data(), buffer_.size());
+      buffer_.clear();
+   }
+   file_.flush();
+}
+
+/** Appends one 3-bit code.
+
+"code" is the code, 0-7.
+
+Precondition: None.
+Postcondition: The code follows the last one written. */
+void DiceJournal::putCode(int code)
+{
+   bits_ |= (uint32_t)(code & 7) << bitCount_;
+   bitCount_ += 3;
+
+   if (bitCount_ >= 8) {
+      buffer_.push_back((uint8_t)bits_);
+      bits_ >>= 8;
+      bitCount_ -= 8;
+
+      if (buffer_.size() >= FLUSH_SIZE) flush();
+   }
+}
+
+/** Appends a signed number after a marker.
+
+"value" is the number.
+
+Precondition: None.
+Postcondition: The number's codes follow the last one written. */
+void DiceJournal::putNumber(int value)
+{
+   uint32_t zigzag = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+
+   do {
+      int code = zigzag & 3;
+      zigzag >>= 2;
+      if (zigzag != 0) code |= 4;
+      putCode(code);
+   } while (zigzag != 0);
+}
+
+/** Appends a marker of the given kind.
+
+"marker" is a JournalMarker.
+
+Precondition: None.
+Postcondition: The marker's codes follow the last one written. */
+void DiceJournal::putMarker(JournalMarker marker)
+{
+   putCode(0);
+   putCode(marker);
+}
+
+/** Returns true, since every die is recorded.
+
+Precondition: None.
+Postcondition: Returns a bool. */
+bool DiceJournal::wantsRolls() const
+{
+   return true;
+}
+
+/** Records that a fight was skipped.
+
+"attackerDead" is true if the attacker is dead, false if the
+defender is.
+
+Precondition: None.
+Postcondition: The marker is in the journal. */
+void DiceJournal::fightSkipped(bool attackerDead)
+{
+   putMarker(MARK_FIGHT_SKIPPED);
+   putCode(attackerDead ? 1 : 0);
+}
+
+/** Records the start of a fight.
+
+"stat" is "WS" or "BS".
+"hitStat" is the attacker's value of that characteristic.
+"damage" is the damage of each unsaved wound.
+
+Precondition: None.
+Postcondition: The marker is in the journal. */
+void DiceJournal::fightStarted(const string& stat, int hitStat, int damage)
+{
+   putMarker(MARK_FIGHT_STARTED);
+   putCode((stat == "WS") ? 1 : (stat == "BS") ? 2 : 0);
+   putNumber(hitStat);
+   putNumber(damage);
+}
+
+/** Records the start of a stage and its threshold.
+
+"stage" is the CombatStage.
+"threshold" is the roll needed to hit or wound, or the save rolled
+against.
+
+Precondition: None.
+Postcondition: The marker is in the journal. */
+void DiceJournal::stageStarted(CombatStage stage, int threshold)
+{
+   drawnFrom_ = -1;
+   putMarker((JournalMarker)(MARK_HIT_STAGE + stage));
+   putNumber(threshold);
+}
+
+/** Records a single die. Its stage is the one last started.
+
+"stage" is the CombatStage it belongs to.
+"roll" is the result, 1-6.
+
+Precondition: None.
+Postcondition: The die is in the journal. */
+void DiceJournal::dieRolled(CombatStage /*stage*/, int roll)
+{
+   putCode(roll);
+}
+
+/** Notes that the current stage's successes were drawn rather than
+rolled, to be recorded when the stage finishes.
+
+"stage" is the CombatStage.
+"count" is the number of dice the successes were drawn from.
+
+Precondition: None.
+Postcondition: The stage is recorded as drawn. */
+void DiceJournal::stageDrawn(CombatStage /*stage*/, int count)
+{
+   drawnFrom_ = count;
+}
+
+/** Records the end of a stage, whether its dice were rolled or
+drawn, and its result. Its stage is the one last started.
+
+"stage" is the CombatStage.
+"result" is the number of hits, the number of wounds, or for the
+save stage the number of failed saves.
+
+Precondition: None.
+Postcondition: The marker is in the journal. */
+void DiceJournal::stageFinished(CombatStage /*stage*/, int result)
+{
+   //Say how the stage was resolved, so a rolled stage with no dice
+   //can't pass for a drawn one.
+   putMarker(MARK_STAGE_FINISHED);
+   if (drawnFrom_ < 0) {
+      putCode(0);
+   }
+   else {
+      putCode(1);
+      putNumber(drawnFrom_);
+   }
+   putNumber(result);
+}
+
+/** Records the end of a fight.
+
+"damage" is the total damage done.
+"woundsLeft" is the defender's remaining wounds.
+
+Precondition: None.
+Postcondition: The marker is in the journal. */
+void DiceJournal::fightFinished(int damage, int woundsLeft)
+{
+   putMarker(MARK_FIGHT_FINISHED);
+   putNumber(damage);
+   putNumber(woundsLeft);
+}
@@ -0,0 +1,186 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Inherits the CombatEventSink class, and records every fight into a
+compact, append-only binary journal for auditing. Each die takes 3 bits,
+and the thresholds and totals of each stage are stored alongside as
+small markers, so a fight can later be replayed or checked by
+JournalReplay without any random numbers.
+
+File layout: the magic "WHDJ" and a uint32 version, then a stream of
+3-bit codes packed least significant bit first.
+
+   1-6  a die rolled in the current stage
+   0    a marker, followed by a 3-bit kind:
+        0 fight started:  stat code (1 WS, 2 BS, 0 other), hit stat, damage
+        1-3 hit/wound/save stage started: threshold
+        4 fight finished: damage done, wounds left
+        5 fight skipped:  1 if the attacker was dead, 0 if the defender was
+        6 stage finished: 0 if the stage's dice were rolled, or 1 and the
+          number of dice if its successes were drawn binomially; then
+          the result
+   7    end of a session; the reader skips to the next byte
+
+Numbers after a marker are zigzag-encoded and written 2 bits per code,
+with the code's top bit set when more codes follow. Each time a journal
+is closed it ends its session, so later sessions can be appended to the
+same file. */
+
+#include "CombatEventSink.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+using namespace std;
+
+/** Kinds of journal marker. */
+enum JournalMarker { MARK_FIGHT_STARTED = 0, MARK_HIT_STAGE = 1, MARK_WOUND_STAGE = 2,
+   MARK_SAVE_STAGE = 3, MARK_FIGHT_FINISHED = 4, MARK_FIGHT_SKIPPED = 5,
+   MARK_STAGE_FINISHED = 6 };
+
+const char JOURNAL_MAGIC[4] = { 'W', 'H', 'D', 'J' };
+const uint32_t JOURNAL_VERSION = 2;
+const int JOURNAL_HEADER_SIZE = 8;
+const int JOURNAL_END_CODE = 7;
+
+class DiceJournal : public CombatEventSink
+{
+private:
+   const size_t FLUSH_SIZE = 65536; //Bytes buffered before writing
+
+   ofstream file_;
+   vector<uint8_t> buffer_;
+   uint32_t bits_;   //Bits not yet forming a whole byte
+   int bitCount_;
+   int drawnFrom_;   //Dice the current stage was drawn from, or -1 if rolled
+
+   /** Appends one 3-bit code.
+
+   "code" is the code, 0-7.
+
+   Precondition: None.
+   Postcondition: The code follows the last one written. */
+   void putCode(int code);
+
+   /** Appends a signed number after a marker.
+
+   "value" is the number.
+
+   Precondition: None.
+   Postcondition: The number's codes follow the last one written. */
+   void putNumber(int value);
+
+   /** Appends a marker of the given kind.
+
+   "marker" is a JournalMarker.
+
+   Precondition: None.
+   Postcondition: The marker's codes follow the last one written. */
+   void putMarker(JournalMarker marker);
+
+public:
+   /** Opens a journal file for appending, writing the header if the file
+   is new or empty. A file that already holds something other than a
+   journal of this version is left alone and not opened.
+
+   "fileName" is the journal's path.
+
+   Precondition: None.
+   Postcondition: Creates a DiceJournal. Check isOpen() for success. */
+   DiceJournal(string fileName);
+
+   /** Ends the session and closes the file.
+
+   Precondition: None.
+   Postcondition: Everything recorded is on disk. */
+   ~DiceJournal();
+
+   /** Returns whether the file was opened for recording.
+
+   Precondition: None.
+   Postcondition: Returns a bool. */
+   bool isOpen() const;
+
+   /** Writes out everything buffered so far except a partial byte.
+
+   Precondition: None.
+   Postcondition: Whole bytes are passed to the file. */
+   void flush();
+
+   /** Returns true, since every die is recorded.
+
+   Precondition: None.
+   Postcondition: Returns a bool. */
+   virtual bool wantsRolls() const;
+
+   /** Records that a fight was skipped.
+
+   "attackerDead" is true if the attacker is dead, false if the
+   defender is.
+
+   Precondition: None.
+   Postcondition: The marker is in the journal. */
+   virtual void fightSkipped(bool attackerDead);
+
+   /** Records the start of a fight.
+
+   "stat" is "WS" or "BS".
+   "hitStat" is the attacker's value of that characteristic.
+   "damage" is the damage of each unsaved wound.
+
+   Precondition: None.
+   Postcondition: The marker is in the journal. */
+   virtual void fightStarted(const string& stat, int hitStat, int damage);
+
+   /** Records the start of a stage and its threshold.
+
+   "stage" is the CombatStage.
+   "threshold" is the roll needed to hit or wound, or the save rolled
+   against.
+
+   Precondition: None.
+   Postcondition: The marker is in the journal. */
+   virtual void stageStarted(CombatStage stage, int threshold);
+
+   /** Records a single die. Its stage is the one last started.
+
+   "stage" is the CombatStage it belongs to.
+   "roll" is the result, 1-6.
+
+   Precondition: None.
+   Postcondition: The die is in the journal. */
+   virtual void dieRolled(CombatStage stage, int roll);
+
+   /** Notes that the current stage's successes were drawn rather than
+   rolled, to be recorded when the stage finishes.
+
+   "stage" is the CombatStage.
+   "count" is the number of dice the successes were drawn from.
+
+   Precondition: None.
+   Postcondition: The stage is recorded as drawn. */
+   virtual void stageDrawn(CombatStage stage, int count);
+
+   /** Records the end of a stage, whether its dice were rolled or
+   drawn, and its result. Its stage is the one last started.
+
+   "stage" is the CombatStage.
+   "result" is the number of hits, the number of wounds, or for the
+   save stage the number of failed saves.
+
+   Precondition: None.
+   Postcondition: The marker is in the journal. */
+   virtual void stageFinished(CombatStage stage, int result);
+
+   /** Records the end of a fight.
+
+   "damage" is the total damage done.
+   "woundsLeft" is the defender's remaining wounds.
+
+   Precondition: None.
+   Postcondition: The marker is in the journal. */
+   virtual void fightFinished(int damage, int woundsLeft);
+};
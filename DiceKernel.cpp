@@ -0,0 +1,164 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Batched d6 rolling for the combat engines. Raw 64-bit random words are
+turned into dice two at a time, and a batch of dice can be counted
+against a threshold in one pass, with AVX2 or plain loops. */
+
+#include "DiceKernel.h"
+#include "CombatRules.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+/** Counts the bits set in a 32-bit mask. */
+static inline int countBits(uint32_t mask)
+{
+#if defined(_MSC_VER)
+   return (int)__popcnt(mask);
+#else
+   return __builtin_popcount(mask);
+#endif
+}
+
+/** Turns random words into d6 results.
+
+"words" holds at least (count + 1) / 2 random 64-bit words.
+"count" is the number of dice wanted.
+"dice" receives count values between 1 and 6.
+
+Precondition: Both arrays must be large enough.
+Postcondition: dice[0..count) is filled. */
+void DiceKernel::rollD6(const uint64_t* words, int count, uint8_t* dice)
+{
+   int i = 0;
+
+#ifdef __AVX2__
+   //Eight dice per step from four words.
+   const __m256i six = _mm256_set1_epi64x(6);
+   const __m256i highHalf = _mm256_set1_epi64x((long long)0xFFFFFFFF00000000ull);
+   const __m256i one = _mm256_set1_epi32(1);
+   const __m256i lowBytes = _mm256_setr_epi8(
+      0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+   const __m256i gather = _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1);
+
+   for (; i + 8 <= count; i += 8) {
+      __m256i raw = _mm256_loadu_si256((const __m256i*)(words + i / 2));
+
+      //High 32 bits of value * 6 is the die minus one.
+      __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(raw, six), 32);
+      __m256i odd = _mm256_and_si256(
+         _mm256_mul_epu32(_mm256_srli_epi64(raw, 32), six), highHalf);
+      __m256i results = _mm256_add_epi32(_mm256_or_si256(even, odd), one);
+
+      //Narrow the eight 32-bit results to bytes.
+      __m256i packed = _mm256_permutevar8x32_epi32(
+         _mm256_shuffle_epi8(results, lowBytes), gather);
+      _mm_storel_epi64((__m128i*)(dice + i), _mm256_castsi256_si128(packed));
+   }
+#endif
+
+   for (; i < count; i++) {
+      uint64_t word = words[i / 2];
+      dice[i] = toD6((i % 2 == 0) ? (uint32_t)word : (uint32_t)(word >> 32));
+   }
+}
+
+/** Counts the dice that rolled the given value or higher.
+
+"dice" holds d6 results.
+"count" is the number of dice.
+"threshold" is the roll needed.
+
+Precondition: None.
+Postcondition: Returns an int between 0 and count. */
+int DiceKernel::countAtLeast(const uint8_t* dice, int count, int threshold)
+{
+   if (threshold <= 1) return count;
+   if (threshold > 6) return 0;
+
+   int total = 0;
+   int i = 0;
+
+#ifdef __AVX2__
+   const __m256i below = _mm256_set1_epi8((char)(threshold - 1));
+   for (; i + 32 <= count; i += 32) {
+      __m256i batch = _mm256_loadu_si256((const __m256i*)(dice + i));
+      __m256i passed = _mm256_cmpgt_epi8(batch, below);
+      total += countBits((uint32_t)_mm256_movemask_epi8(passed));
+   }
+#endif
+
+   for (; i < count; i++) {
+      total += (dice[i] >= threshold) ? 1 : 0;
+   }
+
+   return total;
+}
+
+/** Rolls a batch of dice from a generator.
+
+"rng" is the generator to draw from.
+"count" is the number of dice wanted.
+"dice" receives the results, resized to count.
+
+Precondition: None.
+Postcondition: dice holds count values between 1 and 6. */
+void DiceKernel::roll(CounterRng& rng, int count, vector<uint8_t>& dice)
+{
+   if (count < 0) count = 0;
+
+   //Reused between calls so steady-state rolling never allocates.
+   static thread_local vector<uint64_t> words;
+   words.resize((count + 1) / 2);
+   for (uint64_t& word : words) {
+      word = rng.next64();
+   }
+
+   dice.resize(count);
+   rollD6(words.data(), count, dice.data());
+}
+
+/** Rolls a batch of dice from a generator and counts those at or above
+a threshold, without keeping the individual results.
+
+"rng" is the generator to draw from.
+"count" is the number of dice to roll.
+"threshold" is the roll needed.
+"scratch" is reused storage for the dice.
+
+Precondition: None.
+Postcondition: Returns the number of successes. */
+int DiceKernel::rollAndCount(CounterRng& rng, int count, int threshold,
+   vector<uint8_t>& scratch)
+{
+   roll(rng, count, scratch);
+   return countAtLeast(scratch.data(), count, threshold);
+}
+
+/** Draws the number of dice that would roll the given value or higher
+straight from a binomial distribution, without rolling them.
+
+"rng" is the generator to draw from.
+"count" is the number of dice.
+"threshold" is the roll needed.
+
+Precondition: None.
+Postcondition: Returns the number of successes. Same distribution as
+rollAndCount, at a cost that doesn't grow with count. */
+int DiceKernel::binomialCount(CounterRng& rng, int count, int threshold)
+{
+   if (count <= 0 || threshold > 6) return 0;
+   if (threshold <= 1) return count;
+
+   binomial_distribution<int> successes(count, chanceAtLeast(threshold));
+   return successes(rng);
+}
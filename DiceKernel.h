@@ -0,0 +1,88 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Batched d6 rolling for the combat engines. Raw 64-bit random words are
+turned into dice two at a time (one per 32-bit half, scaled into 1-6 by
+a multiply and shift), and a batch of dice can be counted against a
+threshold in one pass. Both steps use AVX2 when the compiler targets it
+(__AVX2__, e.g. -mavx2 or /arch:AVX2) and fall back to plain loops
+otherwise; the two paths give identical results. */
+
+#include "CounterRng.h"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+class DiceKernel
+{
+public:
+   /** Maps a 32-bit random value onto 1-6. Every path that turns random
+   words into dice goes through this, so they all agree.
+
+   "value" is a uniformly distributed uint32_t.
+
+   Precondition: None.
+   Postcondition: Returns a value between 1 and 6. */
+   static inline uint8_t toD6(uint32_t value)
+   {
+      return (uint8_t)((((uint64_t)value * 6) >> 32) + 1);
+   }
+
+   /** Turns random words into d6 results.
+
+   "words" holds at least (count + 1) / 2 random 64-bit words.
+   "count" is the number of dice wanted.
+   "dice" receives count values between 1 and 6.
+
+   Precondition: Both arrays must be large enough.
+   Postcondition: dice[0..count) is filled. */
+   static void rollD6(const uint64_t* words, int count, uint8_t* dice);
+
+   /** Counts the dice that rolled the given value or higher.
+
+   "dice" holds d6 results.
+   "count" is the number of dice.
+   "threshold" is the roll needed.
+
+   Precondition: None.
+   Postcondition: Returns an int between 0 and count. */
+   static int countAtLeast(const uint8_t* dice, int count, int threshold);
+
+   /** Rolls a batch of dice from a generator.
+
+   "rng" is the generator to draw from.
+   "count" is the number of dice wanted.
+   "dice" receives the results, resized to count.
+
+   Precondition: None.
+   Postcondition: dice holds count values between 1 and 6. */
+   static void roll(CounterRng& rng, int count, vector<uint8_t>& dice);
+
+   /** Rolls a batch of dice from a generator and counts those at or above
+   a threshold, without keeping the individual results.
+
+   "rng" is the generator to draw from.
+   "count" is the number of dice to roll.
+   "threshold" is the roll needed.
+   "scratch" is reused storage for the dice.
+
+   Precondition: None.
+   Postcondition: Returns the number of successes. */
+   static int rollAndCount(CounterRng& rng, int count, int threshold,
+      vector<uint8_t>& scratch);
+
+   /** Draws the number of dice that would roll the given value or higher
+   straight from a binomial distribution, without rolling them.
+
+   "rng" is the generator to draw from.
+   "count" is the number of dice.
+   "threshold" is the roll needed.
+
+   Precondition: None.
+   Postcondition: Returns the number of successes. Same distribution as
+   rollAndCount, at a cost that doesn't grow with count. */
+   static int binomialCount(CounterRng& rng, int count, int threshold);
+};
@@ -0,0 +1,133 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Exact solver for a duel to the death between two Characters, as a
+Markov chain over both sides' remaining wounds. */
+
+#include "DuelSolver.h"
+#include "AnalyticCombat.h"
+#include "MeleeWeapon.h"
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+/** Constructor from the two sides' attacks.
+
+"first" is the first character's attack on the second. Its
+defenderWounds is the second character's starting wounds.
+"second" is the second character's attack back. Its defenderWounds
+is the first character's starting wounds.
+
+Precondition: None.
+Postcondition: Creates a DuelSolver. */
+DuelSolver::DuelSolver(const CombatProfile& first, const CombatProfile& second) :
+   firstDamage_(AnalyticCombat::evaluate(first).probabilities()),
+   secondDamage_(AnalyticCombat::evaluate(second).probabilities()),
+   firstWounds_(second.defenderWounds), secondWounds_(first.defenderWounds)
+{
+}
+
+/** Builds the duel MeleeCombat::fight would play out: both characters
+swing with their first melee weapon.
+
+"first" strikes first each round.
+"second" strikes back.
+
+Precondition: Both characters must have a melee weapon.
+Postcondition: Returns a DuelSolver. Neither character is changed. */
+DuelSolver DuelSolver::melee(Character& first, Character& second)
+{
+   return DuelSolver(first.meleeProfile(second, first.getMeleeAt(0)),
+      second.meleeProfile(first, second.getMeleeAt(0)));
+}
+
+/** Solves the duel.
+
+"maxRounds" is the most rounds to follow. Duels where neither side
+can hurt the other never end, so whatever is left after this many
+rounds is reported as undecided.
+
+Precondition: None.
+Postcondition: Returns a DuelResult. Stops early once all but
+EPSILON of the probability is decided. */
+DuelResult DuelSolver::solve(int maxRounds) const
+{
+   DuelResult result;
+   result.firstWinsAt.push_back(0);
+   result.secondWinsAt.push_back(0);
+   result.firstWins = 0;
+   result.secondWins = 0;
+   result.expectedRounds = 0;
+
+   //A side already at 0 wounds has lost before the duel starts.
+   if (firstWounds_ <= 0 || secondWounds_ <= 0) {
+      result.firstWins = (secondWounds_ <= 0) ? 1 : 0;
+      result.secondWins = 1 - result.firstWins;
+      result.undecided = 0;
+      return result;
+   }
+
+   //state[a * columns + b] is the chance the first has a wounds and the
+   //second b wounds left at the start of a round. Row and column 0 are
+   //never used, since 0 wounds ends the duel.
+   int columns = secondWounds_ + 1;
+   vector<double> state((firstWounds_ + 1) * columns, 0.0);
+   vector<double> middle(state.size(), 0.0);
+   state[firstWounds_ * columns + secondWounds_] = 1;
+   double alive = 1;
+   double decidedRounds = 0;
+
+   for (int round = 1; round <= maxRounds && alive > EPSILON; round++) {
+      double firstWins = 0, secondWins = 0;
+
+      //The first attacks.
+      fill(middle.begin(), middle.end(), 0.0);
+      for (int a = 1; a <= firstWounds_; a++) {
+         for (int b = 1; b <= secondWounds_; b++) {
+            double chance = state[a * columns + b];
+            if (chance == 0) continue;
+
+            for (int damage = 0; unsigned(damage) < firstDamage_.size(); damage++) {
+               if (damage >= b) {
+                  firstWins += chance * firstDamage_[damage];
+               }
+               else {
+                  middle[a * columns + b - damage] += chance * firstDamage_[damage];
+               }
+            }
+         }
+      }
+
+      //The second strikes back if still standing.
+      fill(state.begin(), state.end(), 0.0);
+      for (int a = 1; a <= firstWounds_; a++) {
+         for (int b = 1; b <= secondWounds_; b++) {
+            double chance = middle[a * columns + b];
+            if (chance == 0) continue;
+
+            for (int damage = 0; unsigned(damage) < secondDamage_.size(); damage++) {
+               if (damage >= a) {
+                  secondWins += chance * secondDamage_[damage];
+               }
+               else {
+                  state[(a - damage) * columns + b] += chance * secondDamage_[damage];
+               }
+            }
+         }
+      }
+
+      result.firstWinsAt.push_back(firstWins);
+      result.secondWinsAt.push_back(secondWins);
+      result.firstWins += firstWins;
+      result.secondWins += secondWins;
+      decidedRounds += round * (firstWins + secondWins);
+      alive -= firstWins + secondWins;
+   }
+
+   result.undecided = (alive > 0) ? alive : 0;
+   double decided = result.firstWins + result.secondWins;
+   result.expectedRounds = (decided > 0) ? decidedRounds / decided : 0;
+   return result;
+}
@@ -0,0 +1,75 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Exact solver for a duel to the death between two Characters. Each
+round the first character attacks, then, if still standing, the second
+strikes back, as two Combat::fight calls would. Since one attack's
+damage doesn't depend on how hurt either side is, the duel is a Markov
+chain over (first's wounds, second's wounds), with the damage of each
+attack taken exactly from AnalyticCombat. The solver pushes the
+probability of every state forward one round at a time, collecting
+the chance of each side winning in each round, so no dice are rolled. */
+
+#include "CombatProfile.h"
+#include "Character.h"
+#include <vector>
+
+using namespace std;
+
+/** Outcome of a duel. Round r of firstWinsAt and secondWinsAt holds
+the chance that side wins in exactly that round; index 0 is unused. */
+struct DuelResult
+{
+   vector<double> firstWinsAt;
+   vector<double> secondWinsAt;
+   double firstWins;      //Chance the first character wins
+   double secondWins;     //Chance the second character wins
+   double undecided;      //Chance both are still standing after the last round
+   double expectedRounds; //Mean length of the duels that were decided
+};
+
+class DuelSolver
+{
+private:
+   const double EPSILON = 1e-15; //Probability left undecided at which to stop
+
+   vector<double> firstDamage_;  //Chance of each damage from the first's attack
+   vector<double> secondDamage_; //Chance of each damage from the second's attack
+   int firstWounds_;
+   int secondWounds_;
+
+public:
+   /** Constructor from the two sides' attacks.
+
+   "first" is the first character's attack on the second. Its
+   defenderWounds is the second character's starting wounds.
+   "second" is the second character's attack back. Its defenderWounds
+   is the first character's starting wounds.
+
+   Precondition: None.
+   Postcondition: Creates a DuelSolver. */
+   DuelSolver(const CombatProfile& first, const CombatProfile& second);
+
+   /** Builds the duel MeleeCombat::fight would play out: both characters
+   swing with their first melee weapon.
+
+   "first" strikes first each round.
+   "second" strikes back.
+
+   Precondition: Both characters must have a melee weapon.
+   Postcondition: Returns a DuelSolver. Neither character is changed. */
+   static DuelSolver melee(Character& first, Character& second);
+
+   /** Solves the duel.
+
+   "maxRounds" is the most rounds to follow. Duels where neither side
+   can hurt the other never end, so whatever is left after this many
+   rounds is reported as undecided.
+
+   Precondition: None.
+   Postcondition: Returns a DuelResult. Stops early once all but
+   EPSILON of the probability is decided. */
+   DuelResult solve(int maxRounds = 1000) const;
+};
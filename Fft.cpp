@@ -0,0 +1,127 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Radix-2 fast Fourier transform, and the O(n log n) convolution of two
+probability distributions built on it. */
+
+#include "Fft.h"
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <utility>
+
+using namespace std;
+
+/** Returns the smallest power of two that is at least the given size.
+
+"size" is a positive int.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int Fft::paddedSize(int size)
+{
+   int padded = 1;
+   while (padded < size) padded <<= 1;
+   return padded;
+}
+
+/** Transforms the values in place. The forward transform evaluates the
+polynomial whose coefficients are the values at the roots of unity
+e^(-2 pi i k / n); the inverse transform recovers the coefficients,
+scaled by 1/n.
+
+"values" holds the values. Its size must be a power of two.
+"inverse" is whether to run the inverse transform.
+
+Precondition: values.size() must be a power of two.
+Postcondition: values holds the transform. */
+void Fft::transform(vector<complex<double>>& values, bool inverse)
+{
+   int n = (int)values.size();
+
+   //Put the values in bit-reversed order.
+   for (int i = 1, j = 0; i < n; i++) {
+      int bit = n >> 1;
+      for (; j & bit; bit >>= 1) j ^= bit;
+      j ^= bit;
+      if (i < j) swap(values[i], values[j]);
+   }
+
+   //Every level's twiddles are a stride through the n-th roots of unity,
+   //each worked out directly so rounding doesn't build up.
+   vector<complex<double>> roots(n / 2);
+   for (int k = 0; k < n / 2; k++) {
+      roots[k] = polar(1.0, 2 * PI * k / n * (inverse ? 1 : -1));
+   }
+
+   for (int length = 2; length <= n; length <<= 1) {
+      int stride = n / length;
+      for (int start = 0; start < n; start += length) {
+         for (int k = 0; k < length / 2; k++) {
+            complex<double> even = values[start + k];
+            complex<double> odd = values[start + k + length / 2] * roots[k * stride];
+            values[start + k] = even + odd;
+            values[start + k + length / 2] = even - odd;
+         }
+      }
+   }
+
+   if (inverse) {
+      for (complex<double>& value : values) value /= n;
+   }
+}
+
+/** Returns the convolution of two distributions: the distribution of
+the sum of two independent values drawn from them.
+
+"first" and "second" are indexed by value.
+
+Precondition: None.
+Postcondition: Returns a vector of size first.size() + second.size()
+- 1, or an empty vector if either is empty. Tiny negative results
+from rounding are clamped to 0. */
+vector<double> Fft::convolve(const vector<double>& first, const vector<double>& second)
+{
+   if (first.empty() || second.empty()) return vector<double>();
+
+   int size = (int)(first.size() + second.size() - 1);
+   vector<double> result(size, 0.0);
+
+   //Small inputs are cheaper to combine term by term.
+   if ((int)first.size() < DIRECT_LIMIT || (int)second.size() < DIRECT_LIMIT) {
+      for (int i = 0; unsigned(i) < first.size(); i++) {
+         if (first[i] == 0) continue;
+         for (int j = 0; unsigned(j) < second.size(); j++) {
+            result[i + j] += first[i] * second[j];
+         }
+      }
+      return result;
+   }
+
+   //Both go in one complex transform, first as the real part and second
+   //as the imaginary part, and are separated again by symmetry.
+   int n = paddedSize(size);
+   vector<complex<double>> values(n);
+   for (int i = 0; unsigned(i) < first.size(); i++) values[i].real(first[i]);
+   for (int i = 0; unsigned(i) < second.size(); i++) values[i].imag(second[i]);
+
+   transform(values, false);
+
+   vector<complex<double>> product(n);
+   for (int k = 0; k < n; k++) {
+      complex<double> a = values[k];
+      complex<double> b = conj(values[(n - k) & (n - 1)]);
+      complex<double> firstTerm = (a + b) * 0.5;
+      complex<double> secondTerm = (a - b) * complex<double>(0, -0.5);
+      product[k] = firstTerm * secondTerm;
+   }
+
+   transform(product, true);
+
+   for (int i = 0; i < size; i++) {
+      double value = product[i].real();
+      result[i] = (value > 0) ? value : 0;
+   }
+   return result;
+}
@@ -0,0 +1,53 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Radix-2 fast Fourier transform, and the O(n log n) convolution of two
+probability distributions built on it. Used wherever distributions are
+too large to combine term by term. */
+
+#include <vector>
+#include <complex>
+
+using namespace std;
+
+const double PI = 3.14159265358979323846;
+
+class Fft
+{
+private:
+   static const int DIRECT_LIMIT = 64; //Below this, convolve term by term
+
+public:
+   /** Returns the smallest power of two that is at least the given size.
+
+   "size" is a positive int.
+
+   Precondition: None.
+   Postcondition: Returns an int. */
+   static int paddedSize(int size);
+
+   /** Transforms the values in place. The forward transform evaluates the
+   polynomial whose coefficients are the values at the roots of unity
+   e^(-2 pi i k / n); the inverse transform recovers the coefficients,
+   scaled by 1/n.
+
+   "values" holds the values. Its size must be a power of two.
+   "inverse" is whether to run the inverse transform.
+
+   Precondition: values.size() must be a power of two.
+   Postcondition: values holds the transform. */
+   static void transform(vector<complex<double>>& values, bool inverse);
+
+   /** Returns the convolution of two distributions: the distribution of
+   the sum of two independent values drawn from them.
+
+   "first" and "second" are indexed by value.
+
+   Precondition: None.
+   Postcondition: Returns a vector of size first.size() + second.size()
+   - 1, or an empty vector if either is empty. Tiny negative results
+   from rounding are clamped to 0. */
+   static vector<double> convolve(const vector<double>& first, const vector<double>& second);
+};
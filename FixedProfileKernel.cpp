@@ -0,0 +1,70 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Combat kernels specialised at compile time on a weapon's damage and AP
+and the attacker's number of attacks, and the dispatcher that picks one
+for a CombatProfile. */
+
+#include "FixedProfileKernel.h"
+
+using namespace std;
+
+/** Returns the kernel for a fixed damage and AP and any number of
+attacks from 1 to FIXED_MAX_ATTACKS, or nullptr for any other number. */
+template <int Damage, int AP>
+static FixedProfileKernel::Function findAttacks(int attacks)
+{
+   switch (attacks) {
+   case 1: return &FixedProfileKernel::attack<Damage, AP, 1>;
+   case 2: return &FixedProfileKernel::attack<Damage, AP, 2>;
+   case 3: return &FixedProfileKernel::attack<Damage, AP, 3>;
+   case 4: return &FixedProfileKernel::attack<Damage, AP, 4>;
+   case 5: return &FixedProfileKernel::attack<Damage, AP, 5>;
+   case 6: return &FixedProfileKernel::attack<Damage, AP, 6>;
+   case 7: return &FixedProfileKernel::attack<Damage, AP, 7>;
+   case 8: return &FixedProfileKernel::attack<Damage, AP, 8>;
+   case 9: return &FixedProfileKernel::attack<Damage, AP, 9>;
+   case 10: return &FixedProfileKernel::attack<Damage, AP, 10>;
+   default: return nullptr;
+   }
+}
+
+/** Returns the kernel for a fixed damage and any AP from 0 to
+FIXED_MAX_AP, or nullptr for any other AP or number of attacks. */
+template <int Damage>
+static FixedProfileKernel::Function findAP(int ap, int attacks)
+{
+   switch (ap) {
+   case 0: return findAttacks<Damage, 0>(attacks);
+   case 1: return findAttacks<Damage, 1>(attacks);
+   case 2: return findAttacks<Damage, 2>(attacks);
+   case 3: return findAttacks<Damage, 3>(attacks);
+   default: return nullptr;
+   }
+}
+
+/** Returns the specialisation for a profile.
+
+Kernels cover damage 1-3, AP 0-3 and 1-10 attacks. Flat damage of 1 to
+3 and AP of 0 to 3 are what the great majority of weapons carry, and a
+single model or small squad rarely makes more than 10 attacks, so the
+grid catches most profiles from any roster rather than just the
+shipped one. Every kernel is a separate instantiation, so the grid is
+kept to 120 of them; anything outside it takes the generic path, which
+gives the same results, only more slowly.
+
+"profile" is the matchup.
+
+Precondition: None.
+Postcondition: Returns a Function, or nullptr if no specialisation
+matches and the generic path must be used. */
+FixedProfileKernel::Function FixedProfileKernel::find(const CombatProfile& profile)
+{
+   switch (profile.damage) {
+   case 1: return findAP<1>(profile.ap, profile.attacks);
+   case 2: return findAP<2>(profile.ap, profile.attacks);
+   case 3: return findAP<3>(profile.ap, profile.attacks);
+   default: return nullptr;
+   }
+}
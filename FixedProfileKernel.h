@@ -0,0 +1,90 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Combat kernels specialised at compile time on a weapon's damage and AP
+and the attacker's number of attacks. With those fixed, the compiler can
+unroll the hit stage completely, bound the wound and save stages by a
+constant, and fold the damage multiply and AP adjustment away.
+
+Kernels exist for damage 1 to FIXED_MAX_DAMAGE, AP 0 to FIXED_MAX_AP
+and 1 to FIXED_MAX_ATTACKS attacks. find() picks the one matching a
+CombatProfile, if there is one, and otherwise returns nullptr so the
+caller can fall back to MonteCarlo::rollAttack. A kernel draws exactly the same random words as
+MonteCarlo::rollAttack in DIE_BY_DIE mode, so switching between the two
+never changes a result. */
+
+#include "CombatProfile.h"
+#include "CombatRules.h"
+#include "CounterRng.h"
+#include "DiceKernel.h"
+#include <cstdint>
+
+using namespace std;
+
+const int FIXED_MAX_DAMAGE = 3;   //Largest damage with its own kernels
+const int FIXED_MAX_AP = 3;       //Largest AP with its own kernels
+const int FIXED_MAX_ATTACKS = 10; //Most attacks with their own kernel
+
+class FixedProfileKernel
+{
+public:
+   /** Signature shared by every specialisation. Takes the profile and the
+   generator and returns the damage dealt. */
+   typedef int (*Function)(const CombatProfile& profile, CounterRng& generator);
+
+   /** Rolls one stage of at most MaxDice dice, two per random word, and
+   counts those at or above the threshold.
+
+   "generator" is the generator to roll from.
+   "count" is the number of dice.
+   "threshold" is the roll needed.
+
+   Precondition: count must not be greater than MaxDice.
+   Postcondition: Returns the number of successes. */
+   template <int MaxDice>
+   static inline int countStage(CounterRng& generator, int count, int threshold)
+   {
+      int passed = 0;
+      for (int i = 0; i < MaxDice; i += 2) {
+         if (i >= count) break;
+         uint64_t word = generator.next64();
+         passed += (DiceKernel::toD6((uint32_t)word) >= threshold) ? 1 : 0;
+         if (i + 1 < count) {
+            passed += (DiceKernel::toD6((uint32_t)(word >> 32)) >= threshold) ? 1 : 0;
+         }
+      }
+      return passed;
+   }
+
+   /** Resolves one attack for a fixed damage, AP and number of attacks.
+
+   "profile" is the matchup. Its damage, ap and attacks must equal the
+   template arguments.
+   "generator" is the generator to roll from.
+
+   Precondition: The profile must match the specialisation.
+   Postcondition: Returns the damage dealt. */
+   template <int Damage, int AP, int Attacks>
+   static int attack(const CombatProfile& profile, CounterRng& generator)
+   {
+      int toWound = woundRoll(profile.strength, profile.toughness);
+      int saveRoll = bestSave(profile.armorSave, profile.invulnSave, AP);
+
+      int hits = countStage<Attacks>(generator, Attacks, profile.hitStat);
+      int wounds = countStage<Attacks>(generator, hits, toWound);
+      int saved = countStage<Attacks>(generator, wounds, saveRoll);
+
+      return (wounds - saved) * Damage;
+   }
+
+   /** Returns the specialisation for a profile.
+
+   "profile" is the matchup.
+
+   Precondition: None.
+   Postcondition: Returns a Function, or nullptr if no specialisation
+   matches and the generic path must be used. */
+   static Function find(const CombatProfile& profile);
+};
@@ -0,0 +1,165 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Importance-sampling estimator for the chance that one attack kills its
+target, using the same exponential tilt on the hit, wound and failed
+save stages and weighting each trial by its likelihood ratio. */
+
+#include "ImportanceSampler.h"
+#include "CombatRules.h"
+#include <random>
+#include <cmath>
+
+using namespace std;
+
+/** Constructor with an explicit seed, so runs can be repeated.
+
+"seed" is a 64-bit seed.
+
+Precondition: None.
+Postcondition: Creates an ImportanceSampler. */
+ImportanceSampler::ImportanceSampler(uint64_t seed) : seed_(seed), generator_(seed)
+{
+}
+
+/** Returns a chance after an exponential tilt.
+
+"chance" is the untilted chance of success.
+"tilt" is the tilt.
+
+Precondition: chance must be between 0 and 1.
+Postcondition: Returns a double between 0 and 1. */
+double ImportanceSampler::tilted(double chance, double tilt)
+{
+   if (chance <= 0 || chance >= 1) return chance;
+
+   double raised = chance * exp(tilt);
+   return raised / (1 - chance + raised);
+}
+
+/** Returns the log of the likelihood ratio of one binomial draw.
+
+"successes" and "count" describe the draw.
+"chance" and "tiltedChance" are its chances under the real and the
+tilted dice.
+
+Precondition: None.
+Postcondition: Returns a double. */
+double ImportanceSampler::logRatio(int successes, int count, double chance,
+   double tiltedChance)
+{
+   //Chances of 0 or 1 are never tilted, and the matching terms vanish.
+   double result = 0;
+   if (successes > 0 && chance > 0) {
+      result += successes * log(chance / tiltedChance);
+   }
+   if (count - successes > 0 && chance < 1) {
+      result += (count - successes) * log((1 - chance) / (1 - tiltedChance));
+   }
+   return result;
+}
+
+/** Works out the tilt that makes a kill about as likely as not, by
+raising the chance of an attack getting through all three stages
+to the share of attacks that must get through.
+
+"profile" is the matchup.
+
+Precondition: None.
+Postcondition: Returns the tilt, or 0 if a kill isn't rare enough to
+need one or can't happen at all. */
+double ImportanceSampler::chooseTilt(const CombatProfile& profile)
+{
+   if (profile.attacks <= 0 || profile.damage <= 0) return 0;
+
+   double hit = chanceAtLeast(profile.hitStat);
+   double wound = chanceAtLeast(woundRoll(profile.strength, profile.toughness));
+   double fail = 1 - chanceAtLeast(bestSave(profile.armorSave, profile.invulnSave,
+      profile.ap));
+
+   int needed = (profile.defenderWounds + profile.damage - 1) / profile.damage;
+   if (needed > profile.attacks || hit * wound * fail == 0) return 0;
+
+   double target = (double)needed / profile.attacks;
+   if (hit * wound * fail >= target) return 0;
+
+   //The chance of getting through rises with the tilt, so bisect. If
+   //every stage can reach certainty, cap the target just short of it.
+   if (target >= 1) target = 1 - 1e-6;
+   double low = 0, high = 1;
+   while (tilted(hit, high) * tilted(wound, high) * tilted(fail, high) < target
+      && high < 64) {
+      high *= 2;
+   }
+   for (int i = 0; i < 60; i++) {
+      double middle = (low + high) / 2;
+      if (tilted(hit, middle) * tilted(wound, middle) * tilted(fail, middle) < target) {
+         low = middle;
+      }
+      else {
+         high = middle;
+      }
+   }
+   return high;
+}
+
+/** Estimates the chance that one attack kills the defender.
+
+"profile" is the matchup, killed at defenderWounds damage. A negative
+number of attacks counts as none, as in AnalyticCombat.
+"trials" is the number of trials to run.
+
+Precondition: trials must be positive.
+Postcondition: Returns a RareEventEstimate. Trial i always gets the
+same draws for a given seed. */
+RareEventEstimate ImportanceSampler::killProbability(const CombatProfile& profile,
+   long long trials)
+{
+   //binomial_distribution is undefined for a negative number of trials.
+   int attacks = (profile.attacks > 0) ? profile.attacks : 0;
+   double hit = chanceAtLeast(profile.hitStat);
+   double wound = chanceAtLeast(woundRoll(profile.strength, profile.toughness));
+   double fail = 1 - chanceAtLeast(bestSave(profile.armorSave, profile.invulnSave,
+      profile.ap));
+
+   double tilt = chooseTilt(profile);
+   double tiltedHit = tilted(hit, tilt);
+   double tiltedWound = tilted(wound, tilt);
+   double tiltedFail = tilted(fail, tilt);
+
+   //Sums of the weights of killing trials and of their squares. Trials
+   //that don't kill add nothing to either.
+   double sum = 0, sumOfSquares = 0;
+
+   for (long long i = 0; i < trials; i++) {
+      generator_.seed(seed_, (uint64_t)i);
+
+      int hits = binomial_distribution<int>(attacks, tiltedHit)(generator_);
+      int wounds = binomial_distribution<int>(hits, tiltedWound)(generator_);
+      int failed = binomial_distribution<int>(wounds, tiltedFail)(generator_);
+
+      if (failed * profile.damage < profile.defenderWounds) continue;
+
+      double weight = exp(logRatio(hits, attacks, hit, tiltedHit)
+         + logRatio(wounds, hits, wound, tiltedWound)
+         + logRatio(failed, wounds, fail, tiltedFail));
+      sum += weight;
+      sumOfSquares += weight * weight;
+   }
+
+   RareEventEstimate estimate;
+   estimate.trials = trials;
+   estimate.tilt = tilt;
+   estimate.probability = sum / trials;
+
+   //Variance of the mean of the weighted kills.
+   double secondMoment = sumOfSquares / trials;
+   double spread = secondMoment - estimate.probability * estimate.probability;
+   estimate.variance = (trials > 1 && spread > 0) ? spread / (trials - 1) : 0;
+   estimate.standardError = sqrt(estimate.variance);
+   estimate.relativeError = (estimate.probability > 0)
+      ? estimate.standardError / estimate.probability : 0;
+   estimate.effectiveTrials = (sumOfSquares > 0) ? sum * sum / sumOfSquares : 0;
+   return estimate;
+}
@@ -0,0 +1,91 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Importance-sampling estimator for the chance that one attack kills its
+target, for matchups where a kill is too rare for plain sampling.
+
+Each of the hit, wound and failed-save stages is a binomial draw. The
+sampler exponentially tilts all three stages by the same amount, so
+that under the tilted chances a kill happens about half the time, and
+weights each trial by its likelihood ratio: the chance of its draws
+under the real dice divided by their chance under the tilted ones. The
+mean of the weighted kills is an unbiased estimate of the real kill
+probability, with a far smaller variance than counting kills when they
+are rare. Matchups where a kill isn't rare are sampled untilted. */
+
+#include "CombatProfile.h"
+#include "CounterRng.h"
+#include <cstdint>
+
+using namespace std;
+
+/** Outcome of an importance-sampled estimate. */
+struct RareEventEstimate
+{
+   double probability;        //Estimated kill probability
+   double variance;           //Variance of that estimate
+   double standardError;      //Square root of the variance
+   double relativeError;      //standardError / probability, 0 if no kills
+   double effectiveTrials;    //Trials plain sampling would need for the same weights
+   long long trials;          //Trials run
+   double tilt;               //Exponential tilt applied to every stage, 0 if none
+};
+
+class ImportanceSampler
+{
+private:
+   uint64_t seed_;
+   CounterRng generator_;
+
+   /** Returns a chance after an exponential tilt.
+
+   "chance" is the untilted chance of success.
+   "tilt" is the tilt.
+
+   Precondition: chance must be between 0 and 1.
+   Postcondition: Returns a double between 0 and 1. */
+   static double tilted(double chance, double tilt);
+
+   /** Returns the log of the likelihood ratio of one binomial draw.
+
+   "successes" and "count" describe the draw.
+   "chance" and "tiltedChance" are its chances under the real and the
+   tilted dice.
+
+   Precondition: None.
+   Postcondition: Returns a double. */
+   static double logRatio(int successes, int count, double chance, double tiltedChance);
+
+public:
+   /** Constructor with an explicit seed, so runs can be repeated.
+
+   "seed" is a 64-bit seed.
+
+   Precondition: None.
+   Postcondition: Creates an ImportanceSampler. */
+   ImportanceSampler(uint64_t seed);
+
+   /** Works out the tilt that makes a kill about as likely as not, by
+   raising the chance of an attack getting through all three stages
+   to the share of attacks that must get through.
+
+   "profile" is the matchup.
+
+   Precondition: None.
+   Postcondition: Returns the tilt, or 0 if a kill isn't rare enough to
+   need one or can't happen at all. */
+   static double chooseTilt(const CombatProfile& profile);
+
+   /** Estimates the chance that one attack kills the defender.
+
+   "profile" is the matchup, killed at defenderWounds damage. A negative
+   number of attacks counts as none, as in AnalyticCombat.
+   "trials" is the number of trials to run.
+
+   Precondition: trials must be positive.
+   Postcondition: Returns a RareEventEstimate. Trial i always gets the
+   same draws for a given seed. */
+   RareEventEstimate killProbability(const CombatProfile& profile, long long trials);
+};
@@ -0,0 +1,322 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Reads a journal written by DiceJournal through a memory mapping, and
+replays its fights into a CombatEventSink. */
+
+#include "JournalReplay.h"
+#include "DiceJournal.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/** Constructor. Memory-maps the journal and indexes its fights.
+
+"fileName" is the journal's path.
+
+Precondition: None.
+Postcondition: Creates a JournalReplay. Check isOpen() for success. */
+JournalReplay::JournalReplay(string fileName) : data_(nullptr), size_(0), numBits_(0)
+{
+#ifdef _WIN32
+   mapping_ = nullptr;
+   file_ = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+   if (file_ == INVALID_HANDLE_VALUE) {
+      file_ = nullptr;
+      return;
+   }
+
+   LARGE_INTEGER size;
+   if (!GetFileSizeEx(file_, &size) || size.QuadPart < JOURNAL_HEADER_SIZE) {
+      close();
+      return;
+   }
+
+   mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+   if (mapping_ == nullptr) {
+      close();
+      return;
+   }
+
+   data_ = (const uint8_t*)MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+   size_ = (size_t)size.QuadPart;
+#else
+   file_ = open(fileName.c_str(), O_RDONLY);
+   if (file_ < 0) return;
+
+   struct stat info;
+   if (fstat(file_, &info) != 0 || info.st_size < JOURNAL_HEADER_SIZE) {
+      close();
+      return;
+   }
+
+   void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file_, 0);
+   if (mapped == MAP_FAILED) {
+      close();
+      return;
+   }
+
+   data_ = (const uint8_t*)mapped;
+   size_ = (size_t)info.st_size;
+#endif
+
+   if (data_ == nullptr || memcmp(data_, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0) {
+      close();
+      return;
+   }
+
+   //Codes may mean something else in another version, so don't guess.
+   uint32_t version;
+   memcpy(&version, data_ + sizeof(JOURNAL_MAGIC), sizeof(version));
+   if (version != JOURNAL_VERSION) {
+      close();
+      return;
+   }
+
+   numBits_ = (uint64_t)(size_ - JOURNAL_HEADER_SIZE) * 8;
+   buildIndex();
+}
+
+/** Destructor. Unmaps the file.
+
+Precondition: None.
+Postcondition: The mapping is released. */
+JournalReplay::~JournalReplay()
+{
+   close();
+}
+
+/** Unmaps and closes the file. */
+void JournalReplay::close()
+{
+#ifdef _WIN32
+   if (data_ != nullptr) UnmapViewOfFile(data_);
+   if (mapping_ != nullptr) CloseHandle(mapping_);
+   if (file_ != nullptr) CloseHandle(file_);
+   mapping_ = nullptr;
+   file_ = nullptr;
+#else
+   if (data_ != nullptr) munmap((void*)data_, size_);
+   if (file_ >= 0) ::close(file_);
+   file_ = -1;
+#endif
+   data_ = nullptr;
+   size_ = 0;
+   numBits_ = 0;
+}
+
+/** Returns whether the file was mapped and has a valid header of the
+version this build reads.
+
+Precondition: None.
+Postcondition: Returns a bool. */
+bool JournalReplay::isOpen() const
+{
+   return data_ != nullptr;
+}
+
+/** Returns the number of fights recorded, skipped ones included.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int JournalReplay::numFights() const
+{
+   return (int)fights_.size();
+}
+
+/** Reads the 3-bit code at the given bit, advancing "bit" past it.
+Returns -1 at the end of the journal. Session ends are skipped. */
+int JournalReplay::readCode(uint64_t& bit) const
+{
+   while (bit + 3 <= numBits_) {
+      const uint8_t* byte = data_ + JOURNAL_HEADER_SIZE + (bit >> 3);
+      int shift = (int)(bit & 7);
+
+      uint32_t bits = byte[0];
+      if (shift > 5) bits |= (uint32_t)byte[1] << 8;
+      int code = (bits >> shift) & 7;
+      bit += 3;
+
+      if (code != JOURNAL_END_CODE) return code;
+
+      //The next session starts on the next whole byte.
+      bit = (bit + 7) & ~(uint64_t)7;
+   }
+   return -1;
+}
+
+/** Reads a number written after a marker, advancing "bit" past it. */
+bool JournalReplay::readNumber(uint64_t& bit, int& value) const
+{
+   uint32_t zigzag = 0;
+   int shift = 0;
+   int code;
+
+   do {
+      if (bit + 3 > numBits_ || shift > 30) return false;
+
+      //Codes inside a number are read raw, since 7 is valid data here.
+      const uint8_t* byte = data_ + JOURNAL_HEADER_SIZE + (bit >> 3);
+      uint32_t bits = byte[0];
+      if ((bit & 7) > 5) bits |= (uint32_t)byte[1] << 8;
+      code = (bits >> (bit & 7)) & 7;
+      bit += 3;
+
+      zigzag |= (uint32_t)(code & 3) << shift;
+      shift += 2;
+   } while (code & 4);
+
+   value = (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+   return true;
+}
+
+/** Reads every fight's starting point into fights_. */
+void JournalReplay::buildIndex()
+{
+   uint64_t bit = 0;
+   int value;
+
+   while (true) {
+      int code = readCode(bit);
+      if (code < 0) break;
+      if (code != 0) continue; //A die
+
+      //The marker code was the 3 bits just read.
+      uint64_t start = bit - 3;
+      int marker = readCode(bit);
+      if (marker == MARK_FIGHT_STARTED || marker == MARK_FIGHT_SKIPPED) {
+         fights_.push_back(start);
+      }
+
+      if (marker == MARK_FIGHT_STARTED) {
+         readCode(bit);
+         readNumber(bit, value);
+         readNumber(bit, value);
+      }
+      else if (marker == MARK_FIGHT_SKIPPED) {
+         readCode(bit);
+      }
+      else if (marker == MARK_FIGHT_FINISHED) {
+         readNumber(bit, value);
+         readNumber(bit, value);
+      }
+      else if (marker == MARK_STAGE_FINISHED) {
+         if (readCode(bit) == 1) readNumber(bit, value);
+         readNumber(bit, value);
+      }
+      else if (marker >= 0) {
+         readNumber(bit, value);
+      }
+   }
+}
+
+/** Replays one recorded fight into a sink, and re-checks each stage
+against its recorded dice.
+
+"fight" is the index of the fight, from 0.
+"sink" receives the fight's events exactly as they were recorded.
+
+Precondition: fight is between 0 and numFights() - 1.
+Postcondition: Returns true if every rolled stage gives the same result
+again from its dice and every drawn stage has no more successes than
+dice, false if the journal disagrees with itself or is cut short. */
+bool JournalReplay::replayFight(int fight, CombatEventSink& sink) const
+{
+   if (fight < 0 || fight >= numFights()) return false;
+
+   uint64_t bit = fights_[fight];
+   uint64_t end = (fight + 1 < numFights()) ? fights_[fight + 1] : numBits_;
+   bool rolls = sink.wantsRolls();
+   CombatStage stage = HIT_STAGE;
+   int threshold = 0;
+   int dice = 0;
+   int successes = 0;
+   int value, extra;
+
+   while (bit < end) {
+      int code = readCode(bit);
+      if (code < 0) break;
+
+      if (code != 0) {
+         //A die. Saves count the ones that fail.
+         dice++;
+         if ((stage == SAVE_STAGE) ? (code < threshold) : (code >= threshold)) successes++;
+         if (rolls) sink.dieRolled(stage, code);
+         continue;
+      }
+
+      int marker = readCode(bit);
+      switch (marker) {
+      case MARK_FIGHT_SKIPPED:
+         if ((value = readCode(bit)) < 0) return false;
+         sink.fightSkipped(value == 1);
+         return true;
+      case MARK_FIGHT_STARTED: {
+         int stat = readCode(bit);
+         if (stat < 0 || !readNumber(bit, value) || !readNumber(bit, extra)) return false;
+         sink.fightStarted((stat == 1) ? "WS" : (stat == 2) ? "BS" : "", value, extra);
+         break;
+      }
+      case MARK_HIT_STAGE:
+      case MARK_WOUND_STAGE:
+      case MARK_SAVE_STAGE:
+         if (!readNumber(bit, threshold)) return false;
+         stage = (CombatStage)(marker - MARK_HIT_STAGE);
+         dice = 0;
+         successes = 0;
+         sink.stageStarted(stage, threshold);
+         break;
+      case MARK_STAGE_FINISHED: {
+         //A drawn stage has no dice to check against, but can't have
+         //more successes than dice. A rolled one must match its dice.
+         int drawn = readCode(bit);
+         int count = 0;
+         if (drawn < 0 || drawn > 1) return false;
+         if (drawn == 1 && !readNumber(bit, count)) return false;
+         if (!readNumber(bit, value)) return false;
+         if (drawn == 1) sink.stageDrawn(stage, count);
+         sink.stageFinished(stage, value);
+         if (drawn == 1 && (dice > 0 || value < 0 || value > count)) return false;
+         if (drawn == 0 && successes != value) return false;
+         break;
+      }
+      case MARK_FIGHT_FINISHED:
+         if (!readNumber(bit, value) || !readNumber(bit, extra)) return false;
+         sink.fightFinished(value, extra);
+         return true;
+      default:
+         return false;
+      }
+   }
+   return false;
+}
+
+/** Replays every recorded fight into a sink, in order.
+
+"sink" receives every event in the journal.
+
+Precondition: None.
+Postcondition: Returns the number of fights whose recorded results
+don't match their recorded dice. */
+int JournalReplay::replayAll(CombatEventSink& sink) const
+{
+   int mismatches = 0;
+   for (int i = 0; i < numFights(); i++) {
+      if (!replayFight(i, sink)) mismatches++;
+   }
+   return mismatches;
+}
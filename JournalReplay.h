@@ -0,0 +1,103 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Reads a journal written by DiceJournal. The file is memory-mapped
+rather than read in, and indexed once on opening, so any recorded fight
+can be replayed straight from the recorded dice into a CombatEventSink
+(a ConsoleSink prints the original transcript, a BufferedSink collects
+it for inspection) without touching a random number generator.
+
+Replaying also re-runs the fight: the number of successes in each stage
+is worked out again from the recorded dice and thresholds, and compared
+against what the fight reported. */
+
+#include "CombatEventSink.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+class JournalReplay
+{
+private:
+   const uint8_t* data_;  //Start of the mapped file
+   size_t size_;          //Size of the mapped file in bytes
+   uint64_t numBits_;     //Bits after the header
+   vector<uint64_t> fights_; //Bit at which each fight begins
+
+#ifdef _WIN32
+   void* file_;
+   void* mapping_;
+#else
+   int file_;
+#endif
+
+   /** Reads the 3-bit code at the given bit, advancing "bit" past it.
+   Returns -1 at the end of the journal. Session ends are skipped. */
+   int readCode(uint64_t& bit) const;
+
+   /** Reads a number written after a marker, advancing "bit" past it. */
+   bool readNumber(uint64_t& bit, int& value) const;
+
+   /** Reads every fight's starting point into fights_. */
+   void buildIndex();
+
+   /** Unmaps and closes the file. */
+   void close();
+
+public:
+   /** Constructor. Memory-maps the journal and indexes its fights.
+
+   "fileName" is the journal's path.
+
+   Precondition: None.
+   Postcondition: Creates a JournalReplay. Check isOpen() for success. */
+   JournalReplay(string fileName);
+
+   /** Destructor. Unmaps the file.
+
+   Precondition: None.
+   Postcondition: The mapping is released. */
+   ~JournalReplay();
+
+   JournalReplay(const JournalReplay&) = delete;
+   JournalReplay& operator=(const JournalReplay&) = delete;
+
+   /** Returns whether the file was mapped and has a valid header of the
+   version this build reads.
+
+   Precondition: None.
+   Postcondition: Returns a bool. */
+   bool isOpen() const;
+
+   /** Returns the number of fights recorded, skipped ones included.
+
+   Precondition: None.
+   Postcondition: Returns an int. */
+   int numFights() const;
+
+   /** Replays one recorded fight into a sink, and re-checks each stage
+   against its recorded dice.
+
+   "fight" is the index of the fight, from 0.
+   "sink" receives the fight's events exactly as they were recorded.
+
+   Precondition: fight is between 0 and numFights() - 1.
+   Postcondition: Returns true if every rolled stage gives the same result
+   again from its dice and every drawn stage has no more successes than
+   dice, false if the journal disagrees with itself or is cut short. */
+   bool replayFight(int fight, CombatEventSink& sink) const;
+
+   /** Replays every recorded fight into a sink, in order.
+
+   "sink" receives every event in the journal.
+
+   Precondition: None.
+   Postcondition: Returns the number of fights whose recorded results
+   don't match their recorded dice. */
+   int replayAll(CombatEventSink& sink) const;
+};
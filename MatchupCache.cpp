@@ -0,0 +1,190 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Bounded, thread-safe memo of damage distributions, keyed on the dice
+thresholds, attack count and damage that decide a CombatProfile's
+result. */
+
+#include "MatchupCache.h"
+#include "AnalyticCombat.h"
+#include "CombatRules.h"
+
+using namespace std;
+
+/** Clamps a roll needed on a d6 to 1-7. Anything at or below 1 always
+passes and anything above 6 never does, so those are all the same. */
+static uint64_t clampRoll(int roll)
+{
+   if (roll < 1) return 1;
+   if (roll > 7) return 7;
+   return (uint64_t)roll;
+}
+
+/** Constructor for a cache holding at most the given number of
+distributions.
+
+"capacity" is the maximum number of entries.
+
+Precondition: None.
+Postcondition: Creates an empty MatchupCache. */
+MatchupCache::MatchupCache(size_t capacity) : hits_(0), misses_(0), evictions_(0)
+{
+   shardCapacity_ = (capacity + NUM_SHARDS - 1) / NUM_SHARDS;
+   if (shardCapacity_ == 0) shardCapacity_ = 1;
+}
+
+/** Returns whether a profile's damage is small enough to be part of
+its key, i.e. at most MAX_CACHED_DAMAGE.
+
+"profile" is a CombatProfile.
+
+Precondition: None.
+Postcondition: Returns a bool. */
+bool MatchupCache::cacheable(const CombatProfile& profile)
+{
+   return profile.damage <= MAX_CACHED_DAMAGE;
+}
+
+/** Returns the canonical key of a profile. Profiles with the same key
+have the same damage distribution.
+
+"profile" is a CombatProfile.
+
+Precondition: cacheable(profile) must be true, or profiles whose
+damage differs above MAX_CACHED_DAMAGE would share a key.
+Postcondition: Returns a uint64_t. */
+uint64_t MatchupCache::key(const CombatProfile& profile)
+{
+   uint64_t hit = clampRoll(profile.hitStat);
+   uint64_t wound = clampRoll(woundRoll(profile.strength, profile.toughness));
+   uint64_t save = clampRoll(bestSave(profile.armorSave, profile.invulnSave, profile.ap));
+   uint64_t damage = (profile.damage > 0) ? (uint64_t)profile.damage : 0;
+   uint64_t attacks = (profile.attacks > 0) ? (uint64_t)profile.attacks : 0;
+
+   //[attacks:31][damage:24][save:3][wound:3][hit:3]
+   return (attacks << 33) | (damage << 9) | (save << 6) | (wound << 3) | hit;
+}
+
+/** Returns the damage distribution of a profile, solving it with
+AnalyticCombat and storing it if it isn't cached yet.
+
+"profile" is a CombatProfile.
+
+Precondition: None.
+Postcondition: Returns a shared pointer to the distribution, which
+stays valid even if the entry is later evicted. Profiles that aren't
+cacheable are solved every time, and count as misses. Profiles too
+large for AnalyticCombat to evaluate return nullptr, and leave the
+cache and its counts as they were. */
+shared_ptr<const DamageDistribution> MatchupCache::get(const CombatProfile& profile)
+{
+   if (!AnalyticCombat::canEvaluate(profile)) return nullptr;
+   if (!cacheable(profile)) {
+      misses_++;
+      return make_shared<const DamageDistribution>(AnalyticCombat::evaluate(profile));
+   }
+
+   uint64_t id = key(profile);
+   Shard& shard = shards_[(id ^ (id >> 32) ^ (id >> 17)) % NUM_SHARDS];
+
+   {
+      lock_guard<mutex> guard(shard.lock);
+      auto found = shard.index.find(id);
+      if (found != shard.index.end()) {
+         shard.order.splice(shard.order.begin(), shard.order, found->second);
+         hits_++;
+         return found->second->second;
+      }
+   }
+
+   //Solve outside the lock. Two threads missing on the same key at once
+   //both solve it, and the second simply finds the first's entry.
+   misses_++;
+   shared_ptr<const DamageDistribution> distribution =
+      make_shared<const DamageDistribution>(AnalyticCombat::evaluate(profile));
+
+   lock_guard<mutex> guard(shard.lock);
+   auto found = shard.index.find(id);
+   if (found != shard.index.end()) {
+      return found->second->second;
+   }
+
+   shard.order.push_front(Entry(id, distribution));
+   shard.index[id] = shard.order.begin();
+
+   if (shard.order.size() > shardCapacity_) {
+      shard.index.erase(shard.order.back().first);
+      shard.order.pop_back();
+      evictions_++;
+   }
+
+   return distribution;
+}
+
+/** Returns the number of lookups answered from the cache.
+
+Precondition: None.
+Postcondition: Returns a long long. */
+long long MatchupCache::hits() const
+{
+   return hits_;
+}
+
+/** Returns the number of lookups that had to be solved.
+
+Precondition: None.
+Postcondition: Returns a long long. */
+long long MatchupCache::misses() const
+{
+   return misses_;
+}
+
+/** Returns the number of entries dropped to make room.
+
+Precondition: None.
+Postcondition: Returns a long long. */
+long long MatchupCache::evictions() const
+{
+   return evictions_;
+}
+
+/** Returns the fraction of lookups answered from the cache.
+
+Precondition: None.
+Postcondition: Returns a double between 0 and 1. */
+double MatchupCache::hitRate() const
+{
+   long long total = hits_ + misses_;
+   return (total > 0) ? (double)hits_ / total : 0;
+}
+
+/** Returns the number of entries currently held.
+
+Precondition: None.
+Postcondition: Returns a size_t. */
+size_t MatchupCache::size()
+{
+   size_t total = 0;
+   for (Shard& shard : shards_) {
+      lock_guard<mutex> guard(shard.lock);
+      total += shard.order.size();
+   }
+   return total;
+}
+
+/** Drops every entry and resets the statistics.
+
+Precondition: None.
+Postcondition: The cache is empty. */
+void MatchupCache::clear()
+{
+   for (Shard& shard : shards_) {
+      lock_guard<mutex> guard(shard.lock);
+      shard.order.clear();
+      shard.index.clear();
+   }
+   hits_ = 0;
+   misses_ = 0;
+   evictions_ = 0;
+}
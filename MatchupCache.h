@@ -0,0 +1,129 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Bounded, thread-safe memo of damage distributions. Many characters share
+the same weapon line and defensive profile, so a batch of evaluations
+keeps solving the same distribution over and over. The cache keys each
+CombatProfile on the values that actually decide the result: the roll
+needed to hit, the number of attacks, the roll needed to wound (from S
+and T), the save rolled against (from Sv, Inv and AP) and the damage.
+Two profiles with different raw stats but the same thresholds share an
+entry.
+
+Entries are spread over independently locked shards, each evicting its
+least recently used entry when full. */
+
+#include "CombatProfile.h"
+#include "DamageDistribution.h"
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+class MatchupCache
+{
+private:
+   static const int NUM_SHARDS = 16;
+   static const int MAX_CACHED_DAMAGE = 0xFFFFFF; //Largest damage the key holds
+
+   typedef pair<uint64_t, shared_ptr<const DamageDistribution>> Entry;
+
+   struct Shard
+   {
+      mutex lock;
+      list<Entry> order; //Most recently used first
+      unordered_map<uint64_t, list<Entry>::iterator> index;
+   };
+
+   Shard shards_[NUM_SHARDS];
+   size_t shardCapacity_;
+
+   atomic<long long> hits_;
+   atomic<long long> misses_;
+   atomic<long long> evictions_;
+
+public:
+   /** Constructor for a cache holding at most the given number of
+   distributions.
+
+   "capacity" is the maximum number of entries.
+
+   Precondition: None.
+   Postcondition: Creates an empty MatchupCache. */
+   MatchupCache(size_t capacity = 65536);
+
+   /** Returns whether a profile's damage is small enough to be part of
+   its key, i.e. at most MAX_CACHED_DAMAGE.
+
+   "profile" is a CombatProfile.
+
+   Precondition: None.
+   Postcondition: Returns a bool. */
+   static bool cacheable(const CombatProfile& profile);
+
+   /** Returns the canonical key of a profile. Profiles with the same key
+   have the same damage distribution.
+
+   "profile" is a CombatProfile.
+
+   Precondition: cacheable(profile) must be true, or profiles whose
+   damage differs above MAX_CACHED_DAMAGE would share a key.
+   Postcondition: Returns a uint64_t. */
+   static uint64_t key(const CombatProfile& profile);
+
+   /** Returns the damage distribution of a profile, solving it with
+   AnalyticCombat and storing it if it isn't cached yet.
+
+   "profile" is a CombatProfile.
+
+   Precondition: None.
+   Postcondition: Returns a shared pointer to the distribution, which
+   stays valid even if the entry is later evicted. Profiles that aren't
+   cacheable are solved every time, and count as misses. Profiles too
+   large for AnalyticCombat to evaluate return nullptr, and leave the
+   cache and its counts as they were. */
+   shared_ptr<const DamageDistribution> get(const CombatProfile& profile);
+
+   /** Returns the number of lookups answered from the cache.
+
+   Precondition: None.
+   Postcondition: Returns a long long. */
+   long long hits() const;
+
+   /** Returns the number of lookups that had to be solved.
+
+   Precondition: None.
+   Postcondition: Returns a long long. */
+   long long misses() const;
+
+   /** Returns the number of entries dropped to make room.
+
+   Precondition: None.
+   Postcondition: Returns a long long. */
+   long long evictions() const;
+
+   /** Returns the fraction of lookups answered from the cache.
+
+   Precondition: None.
+   Postcondition: Returns a double between 0 and 1. */
+   double hitRate() const;
+
+   /** Returns the number of entries currently held.
+
+   Precondition: None.
+   Postcondition: Returns a size_t. */
+   size_t size();
+
+   /** Drops every entry and resets the statistics.
+
+   Precondition: None.
+   Postcondition: The cache is empty. */
+   void clear();
+};
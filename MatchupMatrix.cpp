@@ -0,0 +1,287 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Expected damage and kill probability for every attacker x weapon x
+defender combination, evaluated in parallel over cache-sized tiles and
+streamed out as CSV or binary. */
+
+#include "MatchupMatrix.h"
+#include "AnalyticCombat.h"
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <limits>
+#include <cstdint>
+
+using namespace std;
+
+/** Constructor for every matchup within one Army.
+
+"army" supplies both attackers and defenders.
+"numThreads" is the number of workers. If 0, one is started per
+hardware thread.
+
+Precondition: None.
+Postcondition: Creates a MatchupMatrix. */
+MatchupMatrix::MatchupMatrix(const Army& army, int numThreads) : attackers_(army),
+   defenders_(army), sameArmy_(true), pool_(numThreads), cache_(nullptr)
+{
+}
+
+/** Constructor for every matchup of one Army against another.
+
+"attackers" supplies the attacking units.
+"defenders" supplies the defending units.
+"numThreads" is the number of workers. If 0, one is started per
+hardware thread.
+
+Precondition: None.
+Postcondition: Creates a MatchupMatrix. */
+MatchupMatrix::MatchupMatrix(const Army& attackers, const Army& defenders, int numThreads)
+   : attackers_(attackers), defenders_(defenders), sameArmy_(&attackers == &defenders),
+   pool_(numThreads), cache_(nullptr)
+{
+}
+
+/** Shares a cache of solved distributions across evaluations, so
+entries with identical profiles are only solved once. Pass nullptr
+to stop using one.
+
+"cache" is a MatchupCache pointer, owned by the caller.
+
+Precondition: The cache must outlive its use by this matrix.
+Postcondition: Later evaluations go through the cache. */
+void MatchupMatrix::setCache(MatchupCache* cache)
+{
+   cache_ = cache;
+}
+
+/** Evaluates a single entry.
+
+"attacker" is an attacking unit's index.
+"weapon" is one of that unit's weapon indices.
+"defender" is a defending unit's index.
+
+Precondition: The indices must be in range.
+Postcondition: Returns a MatchupEntry. If the profile is too large
+for AnalyticCombat to evaluate, both results are NaN. */
+MatchupEntry MatchupMatrix::evaluate(int attacker, int weapon, int defender) const
+{
+   int wounds = defenders_.stat(CharacterTable::W, defender);
+   CombatProfile profile = attackers_.profile(attacker, weapon, defenders_, defender, wounds);
+
+   //Entries run on pool workers, where a throw would end the program.
+   if (!AnalyticCombat::canEvaluate(profile)) {
+      double unknown = numeric_limits<double>::quiet_NaN();
+      return { attacker, weapon, defender, unknown, unknown };
+   }
+   if (cache_ != nullptr) {
+      shared_ptr<const DamageDistribution> cached = cache_->get(profile);
+      return { attacker, weapon, defender, cached->mean(),
+         cached->killProbability(wounds) };
+   }
+
+   DamageDistribution distribution = AnalyticCombat::evaluate(profile);
+   return { attacker, weapon, defender, distribution.mean(),
+      distribution.killProbability(wounds) };
+}
+
+/** Evaluates every entry of one tile.
+
+"attackerBegin", "attackerEnd" bound the tile's attackers.
+"defenderBegin", "defenderEnd" bound the tile's defenders.
+"entries" receives the tile's entries in attacker, weapon, defender
+order.
+
+Precondition: The bounds must be in range.
+Postcondition: entries is filled. */
+void MatchupMatrix::evaluateTile(int attackerBegin, int attackerEnd, int defenderBegin,
+   int defenderEnd, vector<MatchupEntry>& entries) const
+{
+   for (int attacker = attackerBegin; attacker < attackerEnd; attacker++) {
+      for (int weapon = attackers_.weaponBegin(attacker);
+         weapon < attackers_.weaponEnd(attacker); weapon++) {
+         for (int defender = defenderBegin; defender < defenderEnd; defender++) {
+            if (sameArmy_ && attacker == defender) continue;
+            entries.push_back(evaluate(attacker, weapon, defender));
+         }
+      }
+   }
+}
+
+/** Writes one entry in the given format.
+
+Precondition: None.
+Postcondition: The entry is sent to out. */
+void MatchupMatrix::writeEntry(ostream& out, const MatchupEntry& entry,
+   MatrixFormat format) const
+{
+   if (format == MatrixFormat::BINARY) {
+      int32_t indices[3] = { entry.attacker, entry.weapon, entry.defender };
+      out.write((const char*)indices, sizeof(indices));
+      out.write((const char*)&entry.expectedDamage, sizeof(double));
+      out.write((const char*)&entry.killProbability, sizeof(double));
+      return;
+   }
+
+   ResultWriter::writeCsvField(out, attackers_.getName(entry.attacker));
+   out << ',';
+   ResultWriter::writeCsvField(out, attackers_.getWeaponName(entry.weapon));
+   out << ',';
+   ResultWriter::writeCsvField(out, defenders_.getName(entry.defender));
+   out << ',' << entry.expectedDamage << ',' << entry.killProbability << '\n';
+}
+
+/** Evaluates the whole matrix and streams it to the output.
+
+"out" is the stream to write to. Open it in binary mode for
+MatrixFormat::BINARY.
+"format" is a MatrixFormat.
+
+Precondition: None.
+Postcondition: Every entry has been written. Returns the number of
+entries. */
+long long MatchupMatrix::write(ostream& out, MatrixFormat format)
+{
+   if (format == MatrixFormat::BINARY) {
+      int32_t header[3] = { attackers_.numUnits(), attackers_.numWeapons(),
+         defenders_.numUnits() };
+      out.write("WHMM", 4);
+      out.write((const char*)header, sizeof(header));
+   }
+   else {
+      out << "attacker,weapon,defender,expected_damage,kill_probability\n";
+   }
+
+   long long total = forEachEntry([this, &out, format](const MatchupEntry& entry) {
+      writeEntry(out, entry, format);
+   });
+
+   out.flush();
+   return total;
+}
+
+/** Evaluates the whole matrix and streams it to a ResultWriter, so the
+file is written on the writer's thread while later bands are still
+being evaluated.
+
+"out" is a ResultWriter with five columns: attacker, weapon, defender,
+expected damage and kill probability. Its first three columns are
+labelled with the units' and weapons' names.
+
+Precondition: No rows may have been pushed to out yet.
+Postcondition: Every entry has been queued. Returns the number of
+entries. */
+long long MatchupMatrix::write(ResultWriter& out)
+{
+   vector<string> attackerNames, weaponNames, defenderNames;
+   for (int i = 0; i < attackers_.numUnits(); i++) {
+      attackerNames.push_back(attackers_.getName(i));
+   }
+   for (int i = 0; i < attackers_.numWeapons(); i++) {
+      weaponNames.push_back(attackers_.getWeaponName(i));
+   }
+   for (int i = 0; i < defenders_.numUnits(); i++) {
+      defenderNames.push_back(defenders_.getName(i));
+   }
+   out.setLabels(0, attackerNames);
+   out.setLabels(1, weaponNames);
+   out.setLabels(2, defenderNames);
+
+   return forEachEntry([&out](const MatchupEntry& entry) {
+      double row[5] = { (double)entry.attacker, (double)entry.weapon,
+         (double)entry.defender, entry.expectedDamage, entry.killProbability };
+      out.push(row);
+   });
+}
+
+/** Evaluates the whole matrix, BANDS_IN_FLIGHT bands of attackers at
+a time, and passes each entry to the visitor in attacker, weapon,
+defender order.
+
+"visit" is called once per entry, on the calling thread, while later
+bands are still being evaluated.
+
+Precondition: None.
+Postcondition: Returns the number of entries. */
+long long MatchupMatrix::forEachEntry(const function<void(const MatchupEntry&)>& visit)
+{
+   int numBands = (attackers_.numUnits() + TILE_SIZE - 1) / TILE_SIZE;
+   int numDefenderTiles = (defenders_.numUnits() + TILE_SIZE - 1) / TILE_SIZE;
+   long long total = 0;
+
+   //Band b's tiles go in slot b % BANDS_IN_FLIGHT, which is free again
+   //once band b - BANDS_IN_FLIGHT has been written out.
+   vector<vector<vector<MatchupEntry>>> tiles(BANDS_IN_FLIGHT,
+      vector<vector<MatchupEntry>>(numDefenderTiles));
+   vector<int> pending(BANDS_IN_FLIGHT, 0); //Tiles of each slot still running
+   mutex lock;
+   condition_variable finished;
+
+   auto submitBand = [&](int band) {
+      int slot = band % BANDS_IN_FLIGHT;
+      int begin = band * TILE_SIZE;
+      int end = (begin + TILE_SIZE < attackers_.numUnits())
+         ? begin + TILE_SIZE : attackers_.numUnits();
+      {
+         lock_guard<mutex> guard(lock);
+         pending[slot] = numDefenderTiles;
+      }
+
+      for (int tile = 0; tile < numDefenderTiles; tile++) {
+         tiles[slot][tile].clear();
+         pool_.submit([this, &tiles, &pending, &lock, &finished, slot, begin, end, tile](int) {
+            int defenderBegin = tile * TILE_SIZE;
+            int defenderEnd = (defenderBegin + TILE_SIZE < defenders_.numUnits())
+               ? defenderBegin + TILE_SIZE : defenders_.numUnits();
+            evaluateTile(begin, end, defenderBegin, defenderEnd, tiles[slot][tile]);
+
+            lock_guard<mutex> guard(lock);
+            if (--pending[slot] == 0) finished.notify_all();
+         });
+      }
+   };
+
+   for (int band = 0; band < numBands && band < BANDS_IN_FLIGHT; band++) {
+      submitBand(band);
+   }
+
+   for (int band = 0; band < numBands; band++) {
+      int slot = band % BANDS_IN_FLIGHT;
+      {
+         unique_lock<mutex> guard(lock);
+         finished.wait(guard, [&pending, slot]() { return pending[slot] == 0; });
+      }
+
+      //Each tile is in attacker-major order, so interleave the tiles to
+      //keep the output sorted by attacker, weapon, then defender.
+      int begin = band * TILE_SIZE;
+      int end = (begin + TILE_SIZE < attackers_.numUnits())
+         ? begin + TILE_SIZE : attackers_.numUnits();
+      vector<int> position(numDefenderTiles, 0);
+      for (int attacker = begin; attacker < end; attacker++) {
+         for (int weapon = attackers_.weaponBegin(attacker);
+            weapon < attackers_.weaponEnd(attacker); weapon++) {
+            for (int tile = 0; tile < numDefenderTiles; tile++) {
+               vector<MatchupEntry>& entries = tiles[slot][tile];
+               while (unsigned(position[tile]) < entries.size()
+                  && entries[position[tile]].attacker == attacker
+                  && entries[position[tile]].weapon == weapon) {
+                  visit(entries[position[tile]]);
+                  position[tile]++;
+                  total++;
+               }
+            }
+         }
+      }
+
+      if (band + BANDS_IN_FLIGHT < numBands) submitBand(band + BANDS_IN_FLIGHT);
+   }
+
+   //Every tile has reported in; let the workers drop their last tasks
+   //before the buffers and lock go away.
+   pool_.wait();
+   return total;
+}
@@ -0,0 +1,156 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Expected damage and kill probability for every attacker x weapon x
+defender combination, either within one Army or from one Army against
+another. Each entry is evaluated exactly with AnalyticCombat against
+the defender's full wounds. An entry whose profile is too large for
+AnalyticCombat to hold (see AnalyticCombat::canEvaluate) is recorded
+with NaN for both results rather than stopping the whole matrix.
+
+The attacker/defender grid is cut into square tiles small enough for a
+tile's rows of both tables to stay in cache. Every tile of the next
+BANDS_IN_FLIGHT bands of attackers is queued on a WorkStealingPool at
+once, each filling its own buffer, and the bands are written out in
+order as they finish. The workers never wait for the writing, and
+memory use stays bounded however large the armies are. */
+
+#include "Army.h"
+#include "CharacterTable.h"
+#include "WorkStealingPool.h"
+#include "MatchupCache.h"
+#include "ResultWriter.h"
+#include <iostream>
+#include <vector>
+#include <functional>
+
+using namespace std;
+
+/** Output format of a matchup matrix. CSV has a header row and one line
+per entry, with names quoted where they need to be. BINARY has the
+magic "WHMM", then the number of attackers, weapons and defenders as
+int32s, then one MatchupEntry record per entry (three int32 indices
+and two doubles, little-endian as in memory). */
+enum class MatrixFormat { CSV, BINARY };
+
+/** One cell of the matrix. attacker and defender are unit indices and
+weapon is a weapon index of the attacker's CharacterTable. */
+struct MatchupEntry
+{
+   int attacker;
+   int weapon;
+   int defender;
+   double expectedDamage;
+   double killProbability;
+};
+
+class MatchupMatrix
+{
+private:
+   const int TILE_SIZE = 32;      //Units per tile side
+   const int BANDS_IN_FLIGHT = 4; //Bands of attackers queued ahead of the writing
+
+   CharacterTable attackers_;
+   CharacterTable defenders_;
+   bool sameArmy_; //Skip units attacking themselves
+   WorkStealingPool pool_;
+   MatchupCache* cache_;
+
+   /** Evaluates every entry of one tile.
+
+   "attackerBegin", "attackerEnd" bound the tile's attackers.
+   "defenderBegin", "defenderEnd" bound the tile's defenders.
+   "entries" receives the tile's entries in attacker, weapon, defender
+   order.
+
+   Precondition: The bounds must be in range.
+   Postcondition: entries is filled. */
+   void evaluateTile(int attackerBegin, int attackerEnd, int defenderBegin,
+      int defenderEnd, vector<MatchupEntry>& entries) const;
+
+   /** Writes one entry in the given format.
+
+   Precondition: None.
+   Postcondition: The entry is sent to out. */
+   void writeEntry(ostream& out, const MatchupEntry& entry, MatrixFormat format) const;
+
+   /** Evaluates the whole matrix, BANDS_IN_FLIGHT bands of attackers at
+   a time, and passes each entry to the visitor in attacker, weapon,
+   defender order.
+
+   "visit" is called once per entry, on the calling thread, while later
+   bands are still being evaluated.
+
+   Precondition: None.
+   Postcondition: Returns the number of entries. */
+   long long forEachEntry(const function<void(const MatchupEntry&)>& visit);
+
+public:
+   /** Constructor for every matchup within one Army.
+
+   "army" supplies both attackers and defenders.
+   "numThreads" is the number of workers. If 0, one is started per
+   hardware thread.
+
+   Precondition: None.
+   Postcondition: Creates a MatchupMatrix. */
+   MatchupMatrix(const Army& army, int numThreads = 0);
+
+   /** Constructor for every matchup of one Army against another.
+
+   "attackers" supplies the attacking units.
+   "defenders" supplies the defending units.
+   "numThreads" is the number of workers. If 0, one is started per
+   hardware thread.
+
+   Precondition: None.
+   Postcondition: Creates a MatchupMatrix. */
+   MatchupMatrix(const Army& attackers, const Army& defenders, int numThreads = 0);
+
+   /** Shares a cache of solved distributions across evaluations, so
+   entries with identical profiles are only solved once. Pass nullptr
+   to stop using one.
+
+   "cache" is a MatchupCache pointer, owned by the caller.
+
+   Precondition: The cache must outlive its use by this matrix.
+   Postcondition: Later evaluations go through the cache. */
+   void setCache(MatchupCache* cache);
+
+   /** Evaluates a single entry.
+
+   "attacker" is an attacking unit's index.
+   "weapon" is one of that unit's weapon indices.
+   "defender" is a defending unit's index.
+
+   Precondition: The indices must be in range.
+   Postcondition: Returns a MatchupEntry. If the profile is too large
+   for AnalyticCombat to evaluate, both results are NaN. */
+   MatchupEntry evaluate(int attacker, int weapon, int defender) const;
+
+   /** Evaluates the whole matrix and streams it to the output.
+
+   "out" is the stream to write to. Open it in binary mode for
+   MatrixFormat::BINARY.
+   "format" is a MatrixFormat.
+
+   Precondition: None.
+   Postcondition: Every entry has been written. Returns the number of
+   entries. */
+   long long write(ostream& out, MatrixFormat format);
+
+   /** Evaluates the whole matrix and streams it to a ResultWriter, so the
+   file is written on the writer's thread while later bands are still
+   being evaluated.
+
+   "out" is a ResultWriter with five columns: attacker, weapon, defender,
+   expected damage and kill probability. Its first three columns are
+   labelled with the units' and weapons' names.
+
+   Precondition: No rows may have been pushed to out yet.
+   Postcondition: Every entry has been queued. Returns the number of
+   entries. */
+   long long write(ResultWriter& out);
+};
@@ -0,0 +1,165 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Headless trial engine for a single attacker/weapon/defender matchup.
+Runs the same hit -> wound -> save -> damage chain as Character::combat
+as many times as requested, without printing anything and without
+modifying either Character. */
+
+#include "MonteCarlo.h"
+#include "CombatRules.h"
+#include "CounterRng.h"
+#include "DiceKernel.h"
+#include "FixedProfileKernel.h"
+#include <chrono>
+
+using namespace std;
+
+/** Basic constructor. Seeds the engine from the system clock.
+
+Precondition: None.
+Postcondition: Creates a MonteCarlo object. */
+MonteCarlo::MonteCarlo() : MonteCarlo(
+   (uint64_t)chrono::system_clock::now().time_since_epoch().count())
+{
+}
+
+/** Constructor with an explicit seed, so runs can be repeated.
+
+"seed" is a 64-bit seed.
+
+Precondition: None.
+Postcondition: Creates a MonteCarlo object. */
+MonteCarlo::MonteCarlo(uint64_t seed) : seed_(seed), generator_(seed), mode_(DIE_BY_DIE),
+   writer_(nullptr)
+{
+}
+
+/** Chooses whether each stage rolls every die or draws its number of
+successes from a binomial distribution. Defaults to DIE_BY_DIE.
+
+"mode" is a SamplingMode.
+
+Precondition: None.
+Postcondition: Later trials use the given mode. */
+void MonteCarlo::setSamplingMode(SamplingMode mode)
+{
+   mode_ = mode;
+}
+
+/** Returns the seed the trials are drawn from.
+
+Precondition: None.
+Postcondition: Returns a uint64_t. */
+uint64_t MonteCarlo::getSeed() const
+{
+   return seed_;
+}
+
+/** Streams every later trial to a ResultWriter as a row of the
+trial's index and the damage it did. Pass nullptr to stop.
+
+"writer" is a ResultWriter with two columns, owned by the caller.
+
+Precondition: The writer must outlive its use by this engine.
+Postcondition: Later trials are also sent to the writer. */
+void MonteCarlo::setResultWriter(ResultWriter* writer)
+{
+   writer_ = writer;
+}
+
+/** Simulates one attack with the given generator. Shared by every
+engine that needs single attacks resolved without output.
+
+"profile" is the matchup being simulated.
+"toWound" is the roll needed to wound.
+"saveRoll" is the defender's best save.
+"generator" is the generator to roll from.
+"mode" chooses between rolling each die and binomial draws.
+"dice" is reused storage for the rolls.
+
+Precondition: The thresholds must be the ones computed for profile.
+Postcondition: Returns the damage dealt as an int. */
+int MonteCarlo::rollAttack(const CombatProfile& profile, int toWound, int saveRoll,
+   CounterRng& generator, SamplingMode mode, vector<uint8_t>& dice)
+{
+   if (mode == BINOMIAL) {
+      int totalHits = DiceKernel::binomialCount(generator, profile.attacks,
+         profile.hitStat);
+      int totalWounds = DiceKernel::binomialCount(generator, totalHits, toWound);
+      int failedSaves = totalWounds - DiceKernel::binomialCount(generator,
+         totalWounds, saveRoll);
+      return failedSaves * profile.damage;
+   }
+
+   int totalHits = DiceKernel::rollAndCount(generator, profile.attacks,
+      profile.hitStat, dice);
+   int totalWounds = DiceKernel::rollAndCount(generator, totalHits, toWound, dice);
+   int failedSaves = totalWounds - DiceKernel::rollAndCount(generator, totalWounds,
+      saveRoll, dice);
+
+   return failedSaves * profile.damage;
+}
+
+/** Runs trials 0 through trials - 1 of one matchup.
+
+"profile" is the matchup to simulate.
+"trials" is the number of attacks to simulate.
+
+Precondition: None.
+Postcondition: Returns a SimulationResult. No output is produced. */
+SimulationResult MonteCarlo::run(const CombatProfile& profile, long long trials)
+{
+   SimulationResult result;
+   simulate(profile, 0, trials, result.histogram);
+
+   result.mean = result.histogram.mean();
+   result.variance = result.histogram.variance();
+   result.killProbability = result.histogram.killProbability(profile.defenderWounds);
+   return result;
+}
+
+/** Runs a range of trials and adds them to an existing histogram
+rather than starting a new one. Trial i always gets the same rolls
+for a given seed, however the range is split up.
+
+"profile" is the matchup to simulate.
+"firstTrial" is the index of the first trial in the range.
+"trials" is the number of attacks to simulate.
+"histogram" receives the damage of each trial.
+
+Precondition: None.
+Postcondition: histogram holds trials more results. */
+void MonteCarlo::simulate(const CombatProfile& profile, long long firstTrial,
+   long long trials, DamageHistogram& histogram)
+{
+   //Common profiles have a kernel compiled for them, which rolls the
+   //same dice as the generic path below.
+   FixedProfileKernel::Function kernel = FixedProfileKernel::find(profile);
+   if (mode_ == DIE_BY_DIE && kernel != nullptr) {
+      for (long long i = firstTrial; i < firstTrial + trials; i++) {
+         generator_.seed(seed_, (uint64_t)i);
+         int damage = kernel(profile, generator_);
+         histogram.add(damage);
+         if (writer_ != nullptr) {
+            double row[2] = { (double)i, (double)damage };
+            writer_->push(row);
+         }
+      }
+      return;
+   }
+
+   int toWound = woundRoll(profile.strength, profile.toughness);
+   int saveRoll = bestSave(profile.armorSave, profile.invulnSave, profile.ap);
+
+   for (long long i = firstTrial; i < firstTrial + trials; i++) {
+      generator_.seed(seed_, (uint64_t)i);
+      int damage = rollAttack(profile, toWound, saveRoll, generator_, mode_, dice_);
+      histogram.add(damage);
+      if (writer_ != nullptr) {
+         double row[2] = { (double)i, (double)damage };
+         writer_->push(row);
+      }
+   }
+}
@@ -0,0 +1,146 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Headless trial engine for a single attacker/weapon/defender matchup.
+Runs the same hit -> wound -> save -> damage chain as Character::combat
+as many times as requested, without printing anything and without
+modifying either Character. Works from a CombatProfile, which can be
+built with Character::rangedProfile or Character::meleeProfile.
+
+Each trial draws from its own CounterRng stream, keyed by the seed and
+the trial's index, so a run is reproducible from its seed and any range
+of trials can be simulated on its own with the same results. */
+
+#include "CombatProfile.h"
+#include "DamageHistogram.h"
+#include "CounterRng.h"
+#include "CombatRules.h"
+#include "ResultWriter.h"
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+/** Outcome of a batch of trials. The mean, variance and kill probability
+are taken from the histogram, and the kill probability is measured
+against the profile's defenderWounds. */
+struct SimulationResult
+{
+   DamageHistogram histogram;
+   double mean;
+   double variance;
+   double killProbability;
+};
+
+/** Which estimate an adaptive run measures its precision on. */
+enum PrecisionMetric { MEAN_DAMAGE, KILL_PROBABILITY };
+
+/** Stopping rule for an adaptive run: sample until the confidence
+interval on the chosen estimate is no wider than width, or until
+maxTrials have been run. */
+struct PrecisionTarget
+{
+   PrecisionMetric metric;
+   double width;                     //Full width of the interval to reach
+   double z = 1.96;                  //z-score of the confidence level
+   long long maxTrials = 100000000;  //Stops here even if not converged
+};
+
+/** Outcome of an adaptive run. lower and upper bound the chosen
+estimate, and converged says whether the target width was reached. */
+struct AdaptiveResult
+{
+   SimulationResult result;
+   double lower;
+   double upper;
+   bool converged;
+};
+
+class MonteCarlo
+{
+private:
+   uint64_t seed_;
+   CounterRng generator_;
+   vector<uint8_t> dice_; //Reused between trials
+   SamplingMode mode_;
+   ResultWriter* writer_; //Receives each trial, if set
+
+public:
+   /** Basic constructor. Seeds the engine from the system clock.
+
+   Precondition: None.
+   Postcondition: Creates a MonteCarlo object. */
+   MonteCarlo();
+
+   /** Constructor with an explicit seed, so runs can be repeated.
+
+   "seed" is a 64-bit seed.
+
+   Precondition: None.
+   Postcondition: Creates a MonteCarlo object. */
+   MonteCarlo(uint64_t seed);
+
+   /** Chooses whether each stage rolls every die or draws its number of
+   successes from a binomial distribution. Defaults to DIE_BY_DIE.
+
+   "mode" is a SamplingMode.
+
+   Precondition: None.
+   Postcondition: Later trials use the given mode. */
+   void setSamplingMode(SamplingMode mode);
+
+   /** Returns the seed the trials are drawn from.
+
+   Precondition: None.
+   Postcondition: Returns a uint64_t. */
+   uint64_t getSeed() const;
+
+   /** Streams every later trial to a ResultWriter as a row of the
+   trial's index and the damage it did. Pass nullptr to stop.
+
+   "writer" is a ResultWriter with two columns, owned by the caller.
+
+   Precondition: The writer must outlive its use by this engine.
+   Postcondition: Later trials are also sent to the writer. */
+   void setResultWriter(ResultWriter* writer);
+
+   /** Runs a range of trials and adds them to an existing histogram
+   rather than starting a new one. Trial i always gets the same rolls
+   for a given seed, however the range is split up.
+
+   "profile" is the matchup to simulate.
+   "firstTrial" is the index of the first trial in the range.
+   "trials" is the number of attacks to simulate.
+   "histogram" receives the damage of each trial.
+
+   Precondition: None.
+   Postcondition: histogram holds trials more results. */
+   void simulate(const CombatProfile& profile, long long firstTrial, long long trials,
+      DamageHistogram& histogram);
+
+   /** Simulates one attack with the given generator. Shared by every
+   engine that needs single attacks resolved without output.
+
+   "profile" is the matchup being simulated.
+   "toWound" is the roll needed to wound.
+   "saveRoll" is the defender's best save.
+   "generator" is the generator to roll from.
+   "mode" chooses between rolling each die and binomial draws.
+   "dice" is reused storage for the rolls.
+
+   Precondition: The thresholds must be the ones computed for profile.
+   Postcondition: Returns the damage dealt as an int. */
+   static int rollAttack(const CombatProfile& profile, int toWound, int saveRoll,
+      CounterRng& generator, SamplingMode mode, vector<uint8_t>& dice);
+
+   /** Runs trials 0 through trials - 1 of one matchup.
+
+   "profile" is the matchup to simulate.
+   "trials" is the number of attacks to simulate.
+
+   Precondition: None.
+   Postcondition: Returns a SimulationResult. No output is produced. */
+   SimulationResult run(const CombatProfile& profile, long long trials);
+};
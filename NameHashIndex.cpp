@@ -0,0 +1,206 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Open-addressing hash index from normalised name to Character, with
+linear probing in one flat array. */
+
+#include "NameHashIndex.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+/** Returns the lower-case form of an ASCII character. */
+static inline unsigned char foldCase(unsigned char c)
+{
+   return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+/** Returns whether a character counts as surrounding whitespace. */
+static inline bool isSpace(char c)
+{
+   return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/** Basic constructor. Starts off empty.
+
+Precondition: None.
+Postcondition: Creates an empty NameHashIndex. */
+NameHashIndex::NameHashIndex() : size_(0)
+{
+   slots_.assign(INITIAL_SLOTS, Slot());
+}
+
+/** Returns a name with surrounding whitespace removed.
+
+"name" is any name.
+
+Precondition: None.
+Postcondition: Returns a view into name. */
+string_view NameHashIndex::trim(string_view name)
+{
+   while (!name.empty() && isSpace(name.front())) name.remove_prefix(1);
+   while (!name.empty() && isSpace(name.back())) name.remove_suffix(1);
+   return name;
+}
+
+/** Hashes the normalised form of a name without building it. Uses
+64-bit FNV-1a.
+
+"name" is any name.
+
+Precondition: None.
+Postcondition: Returns the same hash for names that normalise alike. */
+uint64_t NameHashIndex::hashOf(string_view name)
+{
+   uint64_t hash = 14695981039346656037ULL;
+   for (char c : trim(name)) {
+      hash ^= foldCase((unsigned char)c);
+      hash *= 1099511628211ULL;
+   }
+   return hash;
+}
+
+/** Returns whether two names are equal once normalised.
+
+"first" and "second" are the names to compare.
+
+Precondition: None.
+Postcondition: Returns a bool. */
+bool NameHashIndex::foldedEqual(string_view first, string_view second)
+{
+   first = trim(first);
+   second = trim(second);
+   if (first.size() != second.size()) return false;
+
+   for (size_t i = 0; i < first.size(); i++) {
+      if (foldCase((unsigned char)first[i]) != foldCase((unsigned char)second[i])) {
+         return false;
+      }
+   }
+   return true;
+}
+
+/** Returns the name held in a slot as a view into names_.
+
+"slot" is a filled Slot of this index.
+
+Precondition: None.
+Postcondition: Returns a string_view, valid until the next add(). */
+string_view NameHashIndex::nameOf(const Slot& slot) const
+{
+   return string_view(names_.data() + slot.offset, slot.length);
+}
+
+/** Places a filled slot in the first free slot from its hash onward.
+
+"slot" is the Slot to place.
+
+Precondition: The table must have at least one free slot.
+Postcondition: The slot is in slots_. size_ is not changed. */
+void NameHashIndex::place(const Slot& slot)
+{
+   size_t mask = slots_.size() - 1;
+   size_t position = (size_t)slot.hash & mask;
+   while (slots_[position].character != nullptr) {
+      position = (position + 1) & mask;
+   }
+   slots_[position] = slot;
+}
+
+/** Doubles the table and re-places every slot.
+
+Precondition: None.
+Postcondition: slots_ is twice as long and holds the same names. */
+void NameHashIndex::grow()
+{
+   vector<Slot> old(slots_.size() * 2, Slot());
+   old.swap(slots_);
+
+   for (const Slot& slot : old) {
+      if (slot.character != nullptr) place(slot);
+   }
+}
+
+/** Adds a Character under its current name.
+
+"name" is the Character's name.
+"character" is the Character.
+
+Precondition: character must not be nullptr.
+Postcondition: Returns true if added, or false if a Character with
+exactly that name is already in the index. */
+bool NameHashIndex::add(string_view name, Character* character)
+{
+   if (find(name, false) != nullptr) return false;
+
+   //Keep the table at most half full, so probes stay short.
+   if ((size_t)(size_ + 1) * 2 > slots_.size()) grow();
+
+   Slot slot;
+   slot.hash = hashOf(name);
+   slot.offset = (uint32_t)names_.size();
+   slot.length = (uint32_t)name.size();
+   slot.character = character;
+
+   names_.append(name.data(), name.size());
+   place(slot);
+   size_++;
+   return true;
+}
+
+/** Finds a Character by name.
+
+"name" is the name to look for.
+"ignoreCase" is whether names that differ only in case or in
+surrounding whitespace count as equal.
+
+Precondition: None.
+Postcondition: Returns the Character, or nullptr if there is no
+match. If several names match when ignoring case, returns any one
+of them. */
+Character* NameHashIndex::find(string_view name, bool ignoreCase) const
+{
+   uint64_t hash = hashOf(name);
+   size_t mask = slots_.size() - 1;
+
+   for (size_t position = (size_t)hash & mask; slots_[position].character != nullptr;
+      position = (position + 1) & mask) {
+      const Slot& slot = slots_[position];
+      if (slot.hash != hash) continue;
+
+      if (ignoreCase ? foldedEqual(nameOf(slot), name) : nameOf(slot) == name) {
+         return slot.character;
+      }
+   }
+   return nullptr;
+}
+
+/** Returns the normalised form of a name: surrounding whitespace
+removed and ASCII letters folded to lower case.
+
+"name" is any name.
+
+Precondition: None.
+Postcondition: Returns a string. */
+string NameHashIndex::normalise(string_view name)
+{
+   name = trim(name);
+   string result(name.size(), ' ');
+   for (size_t i = 0; i < name.size(); i++) {
+      result[i] = (char)foldCase((unsigned char)name[i]);
+   }
+   return result;
+}
+
+/** Returns the number of Characters in the index.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int NameHashIndex::size() const
+{
+   return size_;
+}
@@ -0,0 +1,133 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Open-addressing hash index from name to Character, kept up to date as
+Characters are added. Names are hashed in normalised form (surrounding
+whitespace trimmed and letters folded to lower case), so the same probe
+finds a name typed exactly or in any mix of cases. Collisions are
+resolved by linear probing in one flat array, and the table doubles
+whenever it is half full, so a lookup costs one or two cache misses.
+
+The names are stored back to back in one string, and lookups take
+string_view keys, so neither adding nor finding a name copies it more
+than once. */
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+class Character;
+
+class NameHashIndex
+{
+private:
+   struct Slot
+   {
+      uint64_t hash;        //Hash of the normalised name
+      uint32_t offset;      //Start of the name in names_
+      uint32_t length;      //Length of the name
+      Character* character; //nullptr if the slot is empty
+   };
+
+   const size_t INITIAL_SLOTS = 16;
+
+   string names_;      //Every name, back to back
+   vector<Slot> slots_;
+   int size_;
+
+   /** Returns a name with surrounding whitespace removed.
+
+   "name" is any name.
+
+   Precondition: None.
+   Postcondition: Returns a view into name. */
+   static string_view trim(string_view name);
+
+   /** Hashes the normalised form of a name without building it. Uses
+   64-bit FNV-1a.
+
+   "name" is any name.
+
+   Precondition: None.
+   Postcondition: Returns the same hash for names that normalise alike. */
+   static uint64_t hashOf(string_view name);
+
+   /** Returns whether two names are equal once normalised.
+
+   "first" and "second" are the names to compare.
+
+   Precondition: None.
+   Postcondition: Returns a bool. */
+   static bool foldedEqual(string_view first, string_view second);
+
+   /** Returns the name held in a slot as a view into names_.
+
+   "slot" is a filled Slot of this index.
+
+   Precondition: None.
+   Postcondition: Returns a string_view, valid until the next add(). */
+   string_view nameOf(const Slot& slot) const;
+
+   /** Places a filled slot in the first free slot from its hash onward.
+
+   "slot" is the Slot to place.
+
+   Precondition: The table must have at least one free slot.
+   Postcondition: The slot is in slots_. size_ is not changed. */
+   void place(const Slot& slot);
+
+   /** Doubles the table and re-places every slot.
+
+   Precondition: None.
+   Postcondition: slots_ is twice as long and holds the same names. */
+   void grow();
+
+public:
+   /** Basic constructor. Starts off empty.
+
+   Precondition: None.
+   Postcondition: Creates an empty NameHashIndex. */
+   NameHashIndex();
+
+   /** Adds a Character under its current name.
+
+   "name" is the Character's name.
+   "character" is the Character.
+
+   Precondition: character must not be nullptr.
+   Postcondition: Returns true if added, or false if a Character with
+   exactly that name is already in the index. */
+   bool add(string_view name, Character* character);
+
+   /** Finds a Character by name.
+
+   "name" is the name to look for.
+   "ignoreCase" is whether names that differ only in case or in
+   surrounding whitespace count as equal.
+
+   Precondition: None.
+   Postcondition: Returns the Character, or nullptr if there is no
+   match. If several names match when ignoring case, returns any one
+   of them. */
+   Character* find(string_view name, bool ignoreCase) const;
+
+   /** Returns the normalised form of a name: surrounding whitespace
+   removed and ASCII letters folded to lower case.
+
+   "name" is any name.
+
+   Precondition: None.
+   Postcondition: Returns a string. */
+   static string normalise(string_view name);
+
+   /** Returns the number of Characters in the index.
+
+   Precondition: None.
+   Postcondition: Returns an int. */
+   int size() const;
+};
@@ -0,0 +1,209 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Trie over normalised Character names, for completing a partly typed
+name and suggesting names close to a mistyped one. */
+
+#include "NameTrie.h"
+#include "NameHashIndex.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+/** Basic constructor. Starts off empty.
+
+Precondition: None.
+Postcondition: Creates a NameTrie holding just the root. */
+NameTrie::NameTrie() : longest_(0)
+{
+   nodes_.push_back(Node{ '\0', NONE, NONE, NONE });
+}
+
+/** Adds a Character under its current name.
+
+"name" is the Character's name.
+"character" is the Character.
+
+Precondition: character must not be nullptr.
+Postcondition: The Character is found by searches for its name. */
+void NameTrie::add(string_view name, Character* character)
+{
+   string key = NameHashIndex::normalise(name);
+   if ((int)key.size() > longest_) longest_ = (int)key.size();
+
+   int32_t node = 0;
+   for (char letter : key) {
+      //Find the child for this letter, or the link to splice it in at
+      //so siblings stay in order.
+      int32_t previous = NONE;
+      int32_t child = nodes_[node].child;
+      while (child != NONE && (unsigned char)nodes_[child].letter < (unsigned char)letter) {
+         previous = child;
+         child = nodes_[child].sibling;
+      }
+
+      if (child == NONE || nodes_[child].letter != letter) {
+         int32_t added = (int32_t)nodes_.size();
+         nodes_.push_back(Node{ letter, NONE, child, NONE });
+         if (previous == NONE) {
+            nodes_[node].child = added;
+         }
+         else {
+            nodes_[previous].sibling = added;
+         }
+         child = added;
+      }
+      node = child;
+   }
+
+   //Append, so Characters sharing a name come back in the order added.
+   int32_t added = (int32_t)values_.size();
+   values_.push_back(Value{ character, NONE });
+   if (nodes_[node].value == NONE) {
+      nodes_[node].value = added;
+   }
+   else {
+      int32_t last = nodes_[node].value;
+      while (values_[last].next != NONE) last = values_[last].next;
+      values_[last].next = added;
+   }
+}
+
+/** Walks the children of a node, extending the edit distance table
+by one row for each, and records every name within maxDistance.
+rows holds one row of target.size() + 1 entries per depth. */
+void NameTrie::searchFrom(int32_t node, int depth, string_view target, int maxDistance,
+   vector<int>& rows, vector<Match>& matches) const
+{
+   int width = (int)target.size() + 1;
+   const int* above = &rows[(size_t)depth * width];
+   int* row = &rows[(size_t)(depth + 1) * width];
+
+   for (int32_t child = nodes_[node].child; child != NONE; child = nodes_[child].sibling) {
+      char letter = nodes_[child].letter;
+
+      row[0] = above[0] + 1;
+      int smallest = row[0];
+      for (int i = 1; i < width; i++) {
+         int substitute = above[i - 1] + ((target[i - 1] == letter) ? 0 : 1);
+         int remove = above[i] + 1;
+         int insert = row[i - 1] + 1;
+         row[i] = min(substitute, min(remove, insert));
+         if (row[i] < smallest) smallest = row[i];
+      }
+
+      int distance = row[width - 1];
+      if (distance <= maxDistance) {
+         for (int32_t value = nodes_[child].value; value != NONE; value = values_[value].next) {
+            matches.push_back(Match{ distance, values_[value].character });
+         }
+      }
+
+      //Every later row is at least the smallest entry of this one, so
+      //nothing below can come back within the limit.
+      if (smallest <= maxDistance) {
+         searchFrom(child, depth + 1, target, maxDistance, rows, matches);
+      }
+   }
+}
+
+/** Lists the Characters in the subtree under a node in alphabetical
+order, the node's own first.
+
+"node" is the root of the subtree.
+"limit" is the most Characters result may hold.
+"result" is the vector being filled.
+
+Precondition: None.
+Postcondition: Appends Characters to result until it holds limit or
+the subtree runs out. */
+void NameTrie::collectFrom(int32_t node, int limit, vector<Character*>& result) const
+{
+   //A name sorts before every longer name it starts.
+   for (int32_t value = nodes_[node].value; value != NONE; value = values_[value].next) {
+      if ((int)result.size() >= limit) return;
+      result.push_back(values_[value].character);
+   }
+
+   for (int32_t child = nodes_[node].child; child != NONE; child = nodes_[child].sibling) {
+      if ((int)result.size() >= limit) return;
+      collectFrom(child, limit, result);
+   }
+}
+
+/** Lists the Characters whose names start with the given text.
+
+"prefix" is the start of a name.
+"limit" is the most Characters to return.
+
+Precondition: None.
+Postcondition: Returns at most limit Characters in alphabetical
+order. Case and surrounding whitespace are ignored. */
+vector<Character*> NameTrie::complete(string_view prefix, int limit) const
+{
+   vector<Character*> result;
+   if (limit <= 0) return result;
+
+   //Every name starting with the prefix is under the node it leads to.
+   int32_t node = 0;
+   for (char letter : NameHashIndex::normalise(prefix)) {
+      int32_t child = nodes_[node].child;
+      while (child != NONE && (unsigned char)nodes_[child].letter < (unsigned char)letter) {
+         child = nodes_[child].sibling;
+      }
+      if (child == NONE || nodes_[child].letter != letter) return result;
+      node = child;
+   }
+
+   collectFrom(node, limit, result);
+   return result;
+}
+
+/** Lists the Characters whose names are within a number of single
+letter insertions, deletions or substitutions of the given name.
+
+"name" is the name as typed.
+"maxDistance" is the most edits allowed.
+"limit" is the most Characters to return.
+
+Precondition: maxDistance must not be negative.
+Postcondition: Returns at most limit Characters, closest first and
+alphabetical among equally close ones. Case and surrounding
+whitespace are ignored. */
+vector<Character*> NameTrie::suggest(string_view name, int maxDistance, int limit) const
+{
+   vector<Character*> result;
+   if (limit <= 0) return result;
+
+   string target = NameHashIndex::normalise(name);
+   int width = (int)target.size() + 1;
+
+   //Row 0 is the distance from the empty string to each prefix of the
+   //target. A name can be no deeper than the longest one added.
+   vector<int> rows((size_t)(longest_ + 1) * width);
+   for (int i = 0; i < width; i++) rows[i] = i;
+
+   vector<Match> matches;
+   if (target.size() <= (size_t)maxDistance) {
+      for (int32_t value = nodes_[0].value; value != NONE; value = values_[value].next) {
+         matches.push_back(Match{ (int)target.size(), values_[value].character });
+      }
+   }
+   searchFrom(0, 0, target, maxDistance, rows, matches);
+
+   //The walk finds names alphabetically, so a stable sort on distance
+   //keeps them that way among equals.
+   stable_sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) {
+      return a.distance < b.distance;
+   });
+
+   for (int i = 0; i < (int)matches.size() && i < limit; i++) {
+      result.push_back(matches[i].character);
+   }
+   return result;
+}
@@ -0,0 +1,115 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Trie over normalised Character names, for completing a partly typed
+name and suggesting names close to a mistyped one. Names are
+normalised the same way as in NameHashIndex, so the search doesn't
+care about case or surrounding whitespace.
+
+Nodes live in one flat array, linked first-child/next-sibling with
+siblings kept in order of their letter, so a search visits names in
+alphabetical order. A completion walks down the typed letters and then
+lists the subtree below in order, stopping at the limit. Suggestions walk the trie once, carrying one
+row of the edit distance table per letter, and drop a branch as soon
+as every entry in its row is over the limit. That keeps a search to
+the small part of the trie near the typed name, however many names
+there are. */
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+class Character;
+
+class NameTrie
+{
+private:
+   struct Node
+   {
+      char letter;      //Letter on the edge into this node
+      int32_t child;    //First child, or NONE
+      int32_t sibling;  //Next sibling with a later letter, or NONE
+      int32_t value;    //First Character whose name ends here, or NONE
+   };
+
+   struct Value
+   {
+      Character* character;
+      int32_t next;     //Next Character with the same name, or NONE
+   };
+
+   /** A Character found by a search, with its edit distance. */
+   struct Match
+   {
+      int distance;
+      Character* character;
+   };
+
+   static const int32_t NONE = -1;
+
+   vector<Node> nodes_;   //nodes_[0] is the root
+   vector<Value> values_;
+   int longest_;          //Length of the longest normalised name
+
+   /** Walks the children of a node, extending the edit distance table
+   by one row for each, and records every name within maxDistance.
+   rows holds one row of target.size() + 1 entries per depth. */
+   void searchFrom(int32_t node, int depth, string_view target, int maxDistance,
+      vector<int>& rows, vector<Match>& matches) const;
+
+   /** Lists the Characters in the subtree under a node in alphabetical
+   order, the node's own first.
+
+   "node" is the root of the subtree.
+   "limit" is the most Characters result may hold.
+   "result" is the vector being filled.
+
+   Precondition: None.
+   Postcondition: Appends Characters to result until it holds limit or
+   the subtree runs out. */
+   void collectFrom(int32_t node, int limit, vector<Character*>& result) const;
+
+public:
+   /** Basic constructor. Starts off empty.
+
+   Precondition: None.
+   Postcondition: Creates a NameTrie holding just the root. */
+   NameTrie();
+
+   /** Adds a Character under its current name.
+
+   "name" is the Character's name.
+   "character" is the Character.
+
+   Precondition: character must not be nullptr.
+   Postcondition: The Character is found by searches for its name. */
+   void add(string_view name, Character* character);
+
+   /** Lists the Characters whose names start with the given text.
+
+   "prefix" is the start of a name.
+   "limit" is the most Characters to return.
+
+   Precondition: None.
+   Postcondition: Returns at most limit Characters in alphabetical
+   order. Case and surrounding whitespace are ignored. */
+   vector<Character*> complete(string_view prefix, int limit) const;
+
+   /** Lists the Characters whose names are within a number of single
+   letter insertions, deletions or substitutions of the given name.
+
+   "name" is the name as typed.
+   "maxDistance" is the most edits allowed.
+   "limit" is the most Characters to return.
+
+   Precondition: maxDistance must not be negative.
+   Postcondition: Returns at most limit Characters, closest first and
+   alphabetical among equally close ones. Case and surrounding
+   whitespace are ignored. */
+   vector<Character*> suggest(string_view name, int maxDistance, int limit) const;
+};
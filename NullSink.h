@@ -0,0 +1,29 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Inherits the CombatEventSink class, and ignores every event. Used for
+batch runs where nobody reads the fight. Since it doesn't want rolls,
+Character::combat skips the per-die calls altogether, leaving only a
+handful of empty calls per fight. */
+
+#include "CombatEventSink.h"
+#include <string>
+
+using namespace std;
+
+class NullSink : public CombatEventSink
+{
+public:
+   /** Returns false, so no per-die events are sent. */
+   virtual bool wantsRolls() const { return false; }
+
+   virtual void fightSkipped(bool /*attackerDead*/) {}
+   virtual void fightStarted(const string& /*stat*/, int /*hitStat*/, int /*damage*/) {}
+   virtual void stageStarted(CombatStage /*stage*/, int /*threshold*/) {}
+   virtual void dieRolled(CombatStage /*stage*/, int /*roll*/) {}
+   virtual void stageDrawn(CombatStage /*stage*/, int /*count*/) {}
+   virtual void stageFinished(CombatStage /*stage*/, int /*result*/) {}
+   virtual void fightFinished(int /*damage*/, int /*woundsLeft*/) {}
+};
@@ -0,0 +1,190 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Spreads the trials of one matchup across every core. The trials are cut
+into chunks and handed to a WorkStealingPool. Each worker records into
+its own DamageHistogram, and the histograms are merged once all chunks
+are done. */
+
+#include "ParallelMonteCarlo.h"
+#include <vector>
+#include <memory>
+
+using namespace std;
+
+//Per-worker histogram, padded so two workers never share a cache line.
+struct alignas(64) WorkerState
+{
+   DamageHistogram histogram;
+};
+
+/** Constructor that starts the worker threads.
+
+"numThreads" is the number of workers. If 0, one is started per
+hardware thread.
+
+Precondition: None.
+Postcondition: Creates a ParallelMonteCarlo object. */
+ParallelMonteCarlo::ParallelMonteCarlo(int numThreads) : pool_(numThreads),
+   mode_(DIE_BY_DIE)
+{
+}
+
+/** Returns the number of worker threads.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int ParallelMonteCarlo::numWorkers() const
+{
+   return pool_.numWorkers();
+}
+
+/** Chooses whether each stage rolls every die or draws its number of
+successes from a binomial distribution. Defaults to DIE_BY_DIE.
+
+"mode" is a SamplingMode.
+
+Precondition: None.
+Postcondition: Later runs use the given mode. */
+void ParallelMonteCarlo::setSamplingMode(SamplingMode mode)
+{
+   mode_ = mode;
+}
+
+/** Runs the given number of trials of one matchup across all workers.
+
+"profile" is the matchup to simulate.
+"trials" is the number of attacks to simulate.
+"seed" seeds the trials.
+
+Precondition: None.
+Postcondition: Returns a SimulationResult holding all trials. No output
+is produced. */
+SimulationResult ParallelMonteCarlo::run(const CombatProfile& profile, long long trials,
+   uint64_t seed)
+{
+   vector<unique_ptr<WorkerState>> workers;
+   for (int i = 0; i < pool_.numWorkers(); i++) {
+      workers.push_back(unique_ptr<WorkerState>(new WorkerState));
+   }
+
+   runTrials(profile, 0, trials, seed, workers);
+   return collect(profile, workers);
+}
+
+/** Keeps running batches of trials until the confidence interval on
+the mean damage or kill probability is as narrow as requested, rather
+than running a fixed number. Each batch is sized from the precision
+reached so far, so easy matchups stop after a few thousand trials
+and rare kills get as many as they need. Trial i is seeded as in
+run(), so the result for a given seed is the same for any number of
+threads.
+
+"profile" is the matchup to simulate.
+"target" is the precision to reach.
+"seed" seeds the trials.
+
+Precondition: target.width and target.maxTrials must be positive.
+Postcondition: Returns an AdaptiveResult. If maxTrials is reached
+first, converged is false and the interval is the one reached. */
+AdaptiveResult ParallelMonteCarlo::runToPrecision(const CombatProfile& profile,
+   const PrecisionTarget& target, uint64_t seed)
+{
+   vector<unique_ptr<WorkerState>> workers;
+   for (int i = 0; i < pool_.numWorkers(); i++) {
+      workers.push_back(unique_ptr<WorkerState>(new WorkerState));
+   }
+
+   //Most damage a single trial can do, for bounding batches that never
+   //saw anything but one outcome.
+   double maxDamage = (double)profile.attacks * profile.damage;
+
+   AdaptiveResult adaptive;
+   long long done = 0;
+   long long batch = FIRST_BATCH;
+
+   while (true) {
+      if (batch > target.maxTrials - done) batch = target.maxTrials - done;
+      runTrials(profile, done, batch, seed, workers);
+      done += batch;
+
+      adaptive.result = collect(profile, workers);
+      const DamageHistogram& histogram = adaptive.result.histogram;
+
+      if (target.metric == KILL_PROBABILITY) {
+         histogram.killInterval(profile.defenderWounds, target.z, adaptive.lower,
+            adaptive.upper);
+      }
+      else {
+         double halfWidth = histogram.meanHalfWidth(target.z);
+
+         //A batch where every trial did the same damage says little about
+         //outcomes too rare to have turned up yet. Fall back on the rule
+         //of three: anything else happens in under 3 trials out of n.
+         if (histogram.variance() == 0) halfWidth = maxDamage * 3 / done / 2;
+
+         adaptive.lower = adaptive.result.mean - halfWidth;
+         adaptive.upper = adaptive.result.mean + halfWidth;
+      }
+
+      double width = adaptive.upper - adaptive.lower;
+      adaptive.converged = (width <= target.width);
+      if (adaptive.converged || done >= target.maxTrials) break;
+
+      //The width shrinks with the square root of the trials, so project
+      //the total needed, but never more than double what's been run.
+      double ratio = width / target.width;
+      long long needed = (long long)(done * ratio * ratio) - done;
+      batch = (needed < FIRST_BATCH) ? FIRST_BATCH : (needed > done) ? done : needed;
+   }
+
+   return adaptive;
+}
+
+/** Runs a range of trials across all workers, adding each trial to the
+running worker's histogram.
+
+"profile" is the matchup to simulate.
+"firstTrial" is the index of the first trial in the range.
+"trials" is the number of trials in the range.
+"seed" seeds the trials.
+"workers" holds one WorkerState per worker.
+
+Precondition: workers must have numWorkers() entries.
+Postcondition: Every trial in the range has been added. */
+void ParallelMonteCarlo::runTrials(const CombatProfile& profile, long long firstTrial,
+   long long trials, uint64_t seed, vector<unique_ptr<WorkerState>>& workers)
+{
+   long long end = firstTrial + trials;
+   for (long long start = firstTrial; start < end; start += CHUNK_SIZE) {
+      long long count = (end - start < CHUNK_SIZE) ? end - start : CHUNK_SIZE;
+
+      SamplingMode mode = mode_;
+      pool_.submit([&workers, &profile, seed, start, count, mode](int worker) {
+         MonteCarlo engine(seed);
+         engine.setSamplingMode(mode);
+         engine.simulate(profile, start, count, workers[worker]->histogram);
+      });
+   }
+
+   pool_.wait();
+}
+
+/** Merges the workers' histograms into one result.
+
+Precondition: None.
+Postcondition: Returns a SimulationResult for every trial so far. */
+SimulationResult ParallelMonteCarlo::collect(const CombatProfile& profile,
+   const vector<unique_ptr<WorkerState>>& workers)
+{
+   SimulationResult result;
+   for (const unique_ptr<WorkerState>& state : workers) {
+      result.histogram.merge(state->histogram);
+   }
+
+   result.mean = result.histogram.mean();
+   result.variance = result.histogram.variance();
+   result.killProbability = result.histogram.killProbability(profile.defenderWounds);
+   return result;
+}
@@ -0,0 +1,107 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Spreads the trials of one matchup across every core. The trials are cut
+into chunks and handed to a WorkStealingPool. Each worker records into
+its own DamageHistogram, and the histograms are merged once all chunks
+are done, so no locking happens while the trials run. Because every
+trial is seeded by its own index, the result for a given seed is the
+same for any number of threads. */
+
+#include "CombatProfile.h"
+#include "MonteCarlo.h"
+#include "WorkStealingPool.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+struct WorkerState;
+
+class ParallelMonteCarlo
+{
+private:
+   const long long CHUNK_SIZE = 16384; //Trials per task
+   const long long FIRST_BATCH = 4096; //Trials before an adaptive run first checks
+
+   WorkStealingPool pool_;
+   SamplingMode mode_; //Passed on to every chunk's engine
+
+   /** Runs a range of trials across all workers, adding each trial to the
+   running worker's histogram.
+
+   "profile" is the matchup to simulate.
+   "firstTrial" is the index of the first trial in the range.
+   "trials" is the number of trials in the range.
+   "seed" seeds the trials.
+   "workers" holds one WorkerState per worker.
+
+   Precondition: workers must have numWorkers() entries.
+   Postcondition: Every trial in the range has been added. */
+   void runTrials(const CombatProfile& profile, long long firstTrial, long long trials,
+      uint64_t seed, vector<unique_ptr<WorkerState>>& workers);
+
+   /** Merges the workers' histograms into one result.
+
+   Precondition: None.
+   Postcondition: Returns a SimulationResult for every trial so far. */
+   static SimulationResult collect(const CombatProfile& profile,
+      const vector<unique_ptr<WorkerState>>& workers);
+
+public:
+   /** Constructor that starts the worker threads.
+
+   "numThreads" is the number of workers. If 0, one is started per
+   hardware thread.
+
+   Precondition: None.
+   Postcondition: Creates a ParallelMonteCarlo object. */
+   ParallelMonteCarlo(int numThreads = 0);
+
+   /** Returns the number of worker threads.
+
+   Precondition: None.
+   Postcondition: Returns an int. */
+   int numWorkers() const;
+
+   /** Chooses whether each stage rolls every die or draws its number of
+   successes from a binomial distribution. Defaults to DIE_BY_DIE.
+
+   "mode" is a SamplingMode.
+
+   Precondition: None.
+   Postcondition: Later runs use the given mode. */
+   void setSamplingMode(SamplingMode mode);
+
+   /** Runs the given number of trials of one matchup across all workers.
+
+   "profile" is the matchup to simulate.
+   "trials" is the number of attacks to simulate.
+   "seed" seeds the trials.
+
+   Precondition: None.
+   Postcondition: Returns a SimulationResult holding all trials. No output
+   is produced. */
+   SimulationResult run(const CombatProfile& profile, long long trials, uint64_t seed);
+
+   /** Keeps running batches of trials until the confidence interval on
+   the mean damage or kill probability is as narrow as requested, rather
+   than running a fixed number. Each batch is sized from the precision
+   reached so far, so easy matchups stop after a few thousand trials
+   and rare kills get as many as they need. Trial i is seeded as in
+   run(), so the result for a given seed is the same for any number of
+   threads.
+
+   "profile" is the matchup to simulate.
+   "target" is the precision to reach.
+   "seed" seeds the trials.
+
+   Precondition: target.width and target.maxTrials must be positive.
+   Postcondition: Returns an AdaptiveResult. If maxTrials is reached
+   first, converged is false and the interval is the one reached. */
+   AdaptiveResult runToPrecision(const CombatProfile& profile, const PrecisionTarget& target,
+      uint64_t seed);
+};
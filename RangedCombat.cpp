@@ -7,6 +7,7 @@ for ranged combat between two Characters. */
 
 #include "Combat.h"
 #include "RangedCombat.h"
+#include "CombatStats.h"
 
 /** Method that executes ranged combat between two Character
 objects.
@@ -19,6 +20,11 @@ the result of the combat. Returns true if succesful fight. Returns false
 if not - for example, if the health attribute of a character is zero. */
 bool RangedCombat::fight(Character* attacker, Character* defender)
 {
+   bool instrumented = CombatStats::enabled();
+   long long start = instrumented ? CombatStats::now() : 0;
+
    attacker->rangedAttack(*defender, defender->getRangedAt(0));
+
+   if (instrumented) CombatStats::addDispatch(CombatStats::now() - start);
    return true; //To Do: add way to check for zero health
 }
\ No newline at end of file
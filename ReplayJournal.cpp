@@ -0,0 +1,81 @@
+/** @ReplayJournal.cpp */
+
+/** Command-line tool for dice journals written by DiceJournal. Prints
+the transcript of every recorded fight, or of one, exactly as
+ConsoleSink showed it at the time, and re-checks each fight's results
+against its recorded dice. Built as its own executable, separately
+from main.cpp.
+
+Usage: ReplayJournal journal [--fight n] [--check]
+   --fight   only replays the fight with index n, from 0
+   --check   prints no transcript, just the number of fights and of
+             fights whose results don't match their dice
+
+Exits with 0 if every replayed fight matched, 1 if any didn't, and 2
+if the journal couldn't be read.
+
+Michael Patrick
+10/17/26 */
+
+#include "JournalReplay.h"
+#include "ConsoleSink.h"
+#include "NullSink.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+   string fileName;
+   int fight = -1;
+   bool check = false;
+   for (int i = 1; i < argc; i++) {
+      string argument = argv[i];
+      if (argument == "--fight" && i + 1 < argc) {
+         fight = atoi(argv[++i]);
+      }
+      else if (argument == "--check") {
+         check = true;
+      }
+      else {
+         fileName = argument;
+      }
+   }
+
+   if (fileName.empty()) {
+      cerr << "Usage: ReplayJournal journal [--fight n] [--check]" << endl;
+      return 2;
+   }
+
+   JournalReplay replay(fileName);
+   if (!replay.isOpen()) {
+      cerr << fileName << " is not a dice journal this version can read." << endl;
+      return 2;
+   }
+
+   ConsoleSink console;
+   NullSink quiet;
+   CombatEventSink& sink = check ? (CombatEventSink&)quiet : (CombatEventSink&)console;
+
+   int mismatches;
+   if (fight >= 0) {
+      if (fight >= replay.numFights()) {
+         cerr << "The journal only holds " << replay.numFights() << " fights." << endl;
+         return 2;
+      }
+      mismatches = replay.replayFight(fight, sink) ? 0 : 1;
+   }
+   else {
+      mismatches = replay.replayAll(sink);
+   }
+
+   if (check) {
+      cout << replay.numFights() << " fights, " << mismatches << " mismatched" << endl;
+   }
+   else if (mismatches > 0) {
+      cerr << mismatches << " fights don't match their recorded dice." << endl;
+   }
+   return (mismatches > 0) ? 1 : 0;
+}
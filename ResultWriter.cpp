@@ -0,0 +1,252 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Streams rows of results to a file as they are produced, through a
+bounded ring buffer drained by a background writer thread. */
+
+#include "ResultWriter.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+/** Constructor. Opens the file and starts the background thread.
+
+"fileName" is the path to write to. Any existing file is replaced.
+"columns" is the name of each column.
+"format" is a ResultFormat.
+"capacity" is the number of rows the buffer holds.
+
+Precondition: columns must not be empty.
+Postcondition: Creates a ResultWriter. Check isOpen() for success. */
+ResultWriter::ResultWriter(string fileName, const vector<string>& columns,
+   ResultFormat format, size_t capacity) : format_(format), columns_(columns),
+   labels_(columns.size()), capacity_(capacity > 0 ? capacity : 1), head_(0),
+   count_(0), written_(0), closing_(false)
+{
+   file_.open(fileName, (format == RESULT_BINARY) ? ios::out | ios::binary : ios::out);
+   if (!file_.is_open()) {
+      closing_ = true;
+      return;
+   }
+
+   //Enough digits that trial and unit indices are never rounded.
+   file_.precision(15);
+   ring_.resize(capacity_ * columns_.size());
+   writeHeader();
+   writer_ = thread(&ResultWriter::writerLoop, this);
+}
+
+/** Destructor. Closes the writer.
+
+Precondition: None.
+Postcondition: Every pushed row is on disk. */
+ResultWriter::~ResultWriter()
+{
+   close();
+}
+
+/** Returns whether the file was opened.
+
+Precondition: None.
+Postcondition: Returns a bool. */
+bool ResultWriter::isOpen() const
+{
+   return file_.is_open();
+}
+
+/** Returns the number of columns in each row.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int ResultWriter::numColumns() const
+{
+   return (int)columns_.size();
+}
+
+/** Prints a column's values as labels in CSV output: a value v is
+printed as labels[v]. Values outside the labels are printed as
+numbers.
+
+"column" is the column's index.
+"labels" is the label of each value.
+
+Precondition: Must be called before the first push.
+Postcondition: The column is labelled. */
+void ResultWriter::setLabels(int column, const vector<string>& labels)
+{
+   if (column < 0 || column >= numColumns()) return;
+
+   lock_guard<mutex> guard(lock_);
+   labels_[column] = labels;
+}
+
+/** Adds one row. Safe to call from several threads at once, though
+rows from different threads may then be interleaved. Blocks while
+the buffer is full.
+
+"values" points to numColumns() values.
+
+Precondition: The writer must not be closed.
+Postcondition: The row is queued for writing. */
+void ResultWriter::push(const double* values)
+{
+   unique_lock<mutex> guard(lock_);
+   notFull_.wait(guard, [this] { return count_ < capacity_ || closing_; });
+   if (closing_) return;
+
+   size_t slot = (head_ + count_) % capacity_;
+   copy(values, values + columns_.size(), ring_.begin() + slot * columns_.size());
+   count_++;
+
+   //The writer only needs waking when it has run dry.
+   if (count_ == 1) notEmpty_.notify_one();
+}
+
+/** Waits for every queued row to be written and closes the file.
+Called by the destructor if not called before.
+
+Precondition: None.
+Postcondition: Returns the number of rows written. */
+long long ResultWriter::close()
+{
+   {
+      lock_guard<mutex> guard(lock_);
+      closing_ = true;
+   }
+   notEmpty_.notify_all();
+   notFull_.notify_all();
+
+   if (writer_.joinable()) writer_.join();
+   if (file_.is_open()) file_.close();
+   return written_;
+}
+
+/** Main loop of the background thread.
+
+Precondition: None.
+Postcondition: Writes rows until the writer is closed and drained. */
+void ResultWriter::writerLoop()
+{
+   vector<double> batch;
+   size_t width = columns_.size();
+
+   while (true) {
+      size_t numRows;
+      {
+         unique_lock<mutex> guard(lock_);
+         notEmpty_.wait(guard, [this] { return count_ > 0 || closing_; });
+         if (count_ == 0) break;
+
+         //Take everything waiting, so the lock is only held for a copy.
+         numRows = count_;
+         batch.resize(numRows * width);
+         for (size_t i = 0; i < numRows; i++) {
+            size_t slot = (head_ + i) % capacity_;
+            copy(ring_.begin() + slot * width, ring_.begin() + (slot + 1) * width,
+               batch.begin() + i * width);
+         }
+         head_ = (head_ + numRows) % capacity_;
+         count_ = 0;
+      }
+      notFull_.notify_all();
+
+      writeRows(batch, numRows);
+      written_ += numRows;
+   }
+
+   file_.flush();
+}
+
+/** Writes a text field as CSV: quoted if it holds a comma, a quote
+or a line break, with any quotes inside doubled, and as it is
+otherwise.
+
+"out" is the stream to write to.
+"field" is the text.
+
+Precondition: None.
+Postcondition: The field is sent to out. */
+void ResultWriter::writeCsvField(ostream& out, const string& field)
+{
+   if (field.find_first_of(",\"\r\n") == string::npos) {
+      out << field;
+      return;
+   }
+
+   out << '"';
+   for (char c : field) {
+      if (c == '"') out << '"';
+      out << c;
+   }
+   out << '"';
+}
+
+/** Writes the header for the chosen format.
+
+Precondition: None.
+Postcondition: The header is sent to the file. */
+void ResultWriter::writeHeader()
+{
+   if (format_ == RESULT_BINARY) {
+      uint32_t numColumns = (uint32_t)columns_.size();
+      file_.write("WHRS", 4);
+      file_.write((const char*)&numColumns, sizeof(numColumns));
+      for (int i = 0; unsigned(i) < columns_.size(); i++) {
+         uint32_t length = (uint32_t)columns_[i].size();
+         file_.write((const char*)&length, sizeof(length));
+         file_.write(columns_[i].data(), length);
+      }
+      return;
+   }
+
+   for (int i = 0; unsigned(i) < columns_.size(); i++) {
+      if (i > 0) file_ << ',';
+      writeCsvField(file_, columns_[i]);
+   }
+   file_ << '\n';
+}
+
+/** Writes a batch of rows taken off the ring buffer.
+
+"rows" holds the rows' values back to back.
+"numRows" is the number of rows in it.
+
+Precondition: None.
+Postcondition: The rows are sent to the file. */
+void ResultWriter::writeRows(const vector<double>& rows, size_t numRows)
+{
+   size_t width = columns_.size();
+
+   if (format_ == RESULT_BINARY) {
+      uint32_t length = (uint32_t)(width * sizeof(double));
+      for (size_t i = 0; i < numRows; i++) {
+         file_.write((const char*)&length, sizeof(length));
+         file_.write((const char*)&rows[i * width], length);
+      }
+      return;
+   }
+
+   for (size_t i = 0; i < numRows; i++) {
+      for (size_t column = 0; column < width; column++) {
+         double value = rows[i * width + column];
+         const vector<string>& labels = labels_[column];
+
+         if (column > 0) file_ << ',';
+         if (value >= 0 && value < labels.size()) {
+            writeCsvField(file_, labels[(size_t)value]);
+         }
+         else {
+            file_ << value;
+         }
+      }
+      file_ << '\n';
+   }
+}
@@ -0,0 +1,147 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Streams rows of results to a file as they are produced. Producers push
+rows into a bounded ring buffer and a background thread formats and
+writes them, so a long run neither holds its results in memory nor
+stalls on the disk; a producer only waits if the writer has fallen a
+whole buffer behind.
+
+Every row has the same numeric columns. CSV output has a header row
+of the column names, and a column can be given labels so that, for
+example, a unit index is printed as the unit's name. BINARY output has
+the magic "WHRS", the number of columns as a uint32, each column name
+as a uint32 length and its characters, and then one record per row:
+a uint32 byte length followed by the row's values as doubles. Labels
+are not written to BINARY output. */
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/** Output format of a ResultWriter. */
+enum ResultFormat { RESULT_CSV, RESULT_BINARY };
+
+class ResultWriter
+{
+private:
+   ofstream file_;
+   ResultFormat format_;
+   vector<string> columns_;
+   vector<vector<string>> labels_; //Per column, empty if unlabelled
+
+   vector<double> ring_; //capacity_ rows of columns_.size() values
+   size_t capacity_;
+   size_t head_;   //Oldest row waiting to be written
+   size_t count_;  //Rows waiting to be written
+   long long written_;
+   bool closing_;
+
+   mutex lock_;
+   condition_variable notEmpty_;
+   condition_variable notFull_;
+   thread writer_;
+
+   /** Main loop of the background thread.
+
+   Precondition: None.
+   Postcondition: Writes rows until the writer is closed and drained. */
+   void writerLoop();
+
+   /** Writes the header for the chosen format.
+
+   Precondition: None.
+   Postcondition: The header is sent to the file. */
+   void writeHeader();
+
+   /** Writes a batch of rows taken off the ring buffer.
+
+   "rows" holds the rows' values back to back.
+   "numRows" is the number of rows in it.
+
+   Precondition: None.
+   Postcondition: The rows are sent to the file. */
+   void writeRows(const vector<double>& rows, size_t numRows);
+
+public:
+   /** Constructor. Opens the file and starts the background thread.
+
+   "fileName" is the path to write to. Any existing file is replaced.
+   "columns" is the name of each column.
+   "format" is a ResultFormat.
+   "capacity" is the number of rows the buffer holds.
+
+   Precondition: columns must not be empty.
+   Postcondition: Creates a ResultWriter. Check isOpen() for success. */
+   ResultWriter(string fileName, const vector<string>& columns,
+      ResultFormat format = RESULT_CSV, size_t capacity = 65536);
+
+   /** Destructor. Closes the writer.
+
+   Precondition: None.
+   Postcondition: Every pushed row is on disk. */
+   ~ResultWriter();
+
+   ResultWriter(const ResultWriter&) = delete;
+   ResultWriter& operator=(const ResultWriter&) = delete;
+
+   /** Returns whether the file was opened.
+
+   Precondition: None.
+   Postcondition: Returns a bool. */
+   bool isOpen() const;
+
+   /** Returns the number of columns in each row.
+
+   Precondition: None.
+   Postcondition: Returns an int. */
+   int numColumns() const;
+
+   /** Prints a column's values as labels in CSV output: a value v is
+   printed as labels[v]. Values outside the labels are printed as
+   numbers.
+
+   "column" is the column's index.
+   "labels" is the label of each value.
+
+   Precondition: Must be called before the first push.
+   Postcondition: The column is labelled. */
+   void setLabels(int column, const vector<string>& labels);
+
+   /** Adds one row. Safe to call from several threads at once, though
+   rows from different threads may then be interleaved. Blocks while
+   the buffer is full.
+
+   "values" points to numColumns() values.
+
+   Precondition: The writer must not be closed.
+   Postcondition: The row is queued for writing. */
+   void push(const double* values);
+
+   /** Writes a text field as CSV: quoted if it holds a comma, a quote
+   or a line break, with any quotes inside doubled, and as it is
+   otherwise.
+
+   "out" is the stream to write to.
+   "field" is the text.
+
+   Precondition: None.
+   Postcondition: The field is sent to out. */
+   static void writeCsvField(ostream& out, const string& field);
+
+   /** Waits for every queued row to be written and closes the file.
+   Called by the destructor if not called before.
+
+   Precondition: None.
+   Postcondition: Returns the number of rows written. */
+   long long close();
+};
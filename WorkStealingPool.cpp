@@ -0,0 +1,164 @@
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Fixed set of worker threads, each with its own queue of tasks. A worker
+takes tasks from the back of its own queue and, once that is empty,
+steals from the front of the other workers' queues. */
+
+#include "WorkStealingPool.h"
+
+using namespace std;
+
+//Which pool and worker the current thread belongs to, so that tasks
+//submitted from inside a task land on the submitting worker's queue.
+static thread_local WorkStealingPool* currentPool = nullptr;
+static thread_local int currentWorker = -1;
+
+/** Starts the worker threads.
+
+"numThreads" is the number of workers. If 0, one worker is started
+per hardware thread.
+
+Precondition: None.
+Postcondition: Creates a WorkStealingPool with idle workers. */
+WorkStealingPool::WorkStealingPool(int numThreads) : queued_(0), pending_(0),
+   nextQueue_(0), stopping_(false)
+{
+   if (numThreads <= 0) numThreads = (int)thread::hardware_concurrency();
+   if (numThreads <= 0) numThreads = 1;
+
+   for (int i = 0; i < numThreads; i++) {
+      queues_.push_back(unique_ptr<WorkerQueue>(new WorkerQueue));
+   }
+   for (int i = 0; i < numThreads; i++) {
+      threads_.push_back(thread(&WorkStealingPool::workerLoop, this, i));
+   }
+}
+
+/** Waits for any remaining tasks and joins the worker threads.
+
+Precondition: None.
+Postcondition: All threads are stopped. */
+WorkStealingPool::~WorkStealingPool()
+{
+   wait();
+
+   {
+      lock_guard<mutex> guard(sleepLock_);
+      stopping_ = true;
+   }
+   workReady_.notify_all();
+
+   for (thread& worker : threads_) {
+      worker.join();
+   }
+}
+
+/** Returns the number of worker threads.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int WorkStealingPool::numWorkers() const
+{
+   return (int)threads_.size();
+}
+
+/** Queues a task. Tasks submitted from inside a worker go to that
+worker's own queue, others are spread round-robin.
+
+"task" is a function taking the index of the worker that runs it.
+
+Precondition: None.
+Postcondition: The task will be run by one of the workers. */
+void WorkStealingPool::submit(function<void(int)> task)
+{
+   int index = (currentPool == this) ? currentWorker
+      : (int)(nextQueue_++ % queues_.size());
+
+   pending_++;
+   {
+      lock_guard<mutex> guard(queues_[index]->lock);
+      queues_[index]->tasks.push_back(move(task));
+   }
+   queued_++;
+
+   //Taking the lock orders this notify after any worker that has just
+   //checked for work and is about to sleep.
+   { lock_guard<mutex> guard(sleepLock_); }
+   workReady_.notify_one();
+}
+
+/** Blocks until every submitted task has finished.
+
+Precondition: Must not be called from inside a task.
+Postcondition: No tasks are queued or running. */
+void WorkStealingPool::wait()
+{
+   unique_lock<mutex> lock(sleepLock_);
+   allDone_.wait(lock, [this] { return pending_ == 0; });
+}
+
+/** Takes the next task for the given worker, first from its own
+queue and then by stealing from the others.
+
+"index" is the worker looking for work.
+"task" receives the task if one is found.
+
+Precondition: None.
+Postcondition: Returns true if a task was taken. */
+bool WorkStealingPool::takeTask(int index, function<void(int)>& task)
+{
+   int count = (int)queues_.size();
+
+   for (int i = 0; i < count; i++) {
+      WorkerQueue& queue = *queues_[(index + i) % count];
+      lock_guard<mutex> guard(queue.lock);
+
+      if (queue.tasks.empty()) continue;
+
+      //Own work is taken newest first, stolen work oldest first.
+      if (i == 0) {
+         task = move(queue.tasks.back());
+         queue.tasks.pop_back();
+      }
+      else {
+         task = move(queue.tasks.front());
+         queue.tasks.pop_front();
+      }
+      queued_--;
+      return true;
+   }
+
+   return false;
+}
+
+/** Main loop of each worker thread.
+
+"index" is the worker's position in queues_.
+
+Precondition: None.
+Postcondition: Runs tasks until the pool is destroyed. */
+void WorkStealingPool::workerLoop(int index)
+{
+   currentPool = this;
+   currentWorker = index;
+
+   function<void(int)> task;
+   while (true) {
+      if (takeTask(index, task)) {
+         task(index);
+         task = nullptr;
+
+         if (--pending_ == 0) {
+            lock_guard<mutex> guard(sleepLock_);
+            allDone_.notify_all();
+         }
+         continue;
+      }
+
+      unique_lock<mutex> lock(sleepLock_);
+      workReady_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+      if (stopping_ && queued_ == 0) return;
+   }
+}
@@ -0,0 +1,98 @@
+#pragma once
+/** Michael Patrick
+10/17/26
+Warhammer-Simulator
+
+Fixed set of worker threads, each with its own queue of tasks. A worker
+takes tasks from the back of its own queue and, once that is empty,
+steals from the front of the other workers' queues, so uneven batches
+still keep every core busy. Each task is told the index of the worker
+running it, which lets callers keep per-worker state without locking. */
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+using namespace std;
+
+class WorkStealingPool
+{
+private:
+   struct WorkerQueue
+   {
+      mutex lock;
+      deque<function<void(int)>> tasks;
+   };
+
+   vector<unique_ptr<WorkerQueue>> queues_;
+   vector<thread> threads_;
+
+   atomic<long long> queued_;  //Tasks sitting in a queue
+   atomic<long long> pending_; //Tasks queued or running
+   atomic<unsigned> nextQueue_;
+   bool stopping_;
+
+   mutex sleepLock_;
+   condition_variable workReady_;
+   condition_variable allDone_;
+
+   /** Main loop of each worker thread.
+
+   "index" is the worker's position in queues_.
+
+   Precondition: None.
+   Postcondition: Runs tasks until the pool is destroyed. */
+   void workerLoop(int index);
+
+   /** Takes the next task for the given worker, first from its own
+   queue and then by stealing from the others.
+
+   "index" is the worker looking for work.
+   "task" receives the task if one is found.
+
+   Precondition: None.
+   Postcondition: Returns true if a task was taken. */
+   bool takeTask(int index, function<void(int)>& task);
+
+public:
+   /** Starts the worker threads.
+
+   "numThreads" is the number of workers. If 0, one worker is started
+   per hardware thread.
+
+   Precondition: None.
+   Postcondition: Creates a WorkStealingPool with idle workers. */
+   WorkStealingPool(int numThreads = 0);
+
+   /** Waits for any remaining tasks and joins the worker threads.
+
+   Precondition: None.
+   Postcondition: All threads are stopped. */
+   ~WorkStealingPool();
+
+   /** Returns the number of worker threads.
+
+   Precondition: None.
+   Postcondition: Returns an int. */
+   int numWorkers() const;
+
+   /** Queues a task. Tasks submitted from inside a worker go to that
+   worker's own queue, others are spread round-robin.
+
+   "task" is a function taking the index of the worker that runs it.
+
+   Precondition: None.
+   Postcondition: The task will be run by one of the workers. */
+   void submit(function<void(int)> task);
+
+   /** Blocks until every submitted task has finished.
+
+   Precondition: Must not be called from inside a task.
+   Postcondition: No tasks are queued or running. */
+   void wait();
+};
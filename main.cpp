@@ -8,6 +8,7 @@ Michael Patrick
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include "Army.h"
 #include "Character.h"
 #include "CombatFactory.h"
@@ -15,8 +16,31 @@ Michael Patrick
 
 using namespace std;
 
+const int SUGGESTION_LIMIT = 5; //Most names offered after a miss
+
+/** Works out which names to offer after a name wasn't found: those that
+start with what was typed, or failing that, those within a couple of
+typos of it.
+
+"army" is some Army object.
+"name" is the name as typed.
+
+Precondition: None.
+Postcondition: Returns at most SUGGESTION_LIMIT Character pointers. */
+vector<Character*> suggestCharacters(const Army& army, const string& name)
+{
+   vector<Character*> suggestions = army.complete(name, SUGGESTION_LIMIT);
+   if (suggestions.empty()) {
+      //Allow fewer typos in short names, or everything would match.
+      int maxDistance = (name.size() <= 4) ? 1 : 2;
+      suggestions = army.suggest(name, maxDistance, SUGGESTION_LIMIT);
+   }
+   return suggestions;
+}
+
 /** Creates an instance that requires the user to input a character
-name, and assigns it to the Character object passed by value.
+name, and assigns it to the Character object passed by value. If the
+name isn't found, offers similar names, which can be picked by number.
 
 "army" is some Army object.
 
@@ -32,12 +56,41 @@ Character* getCharacter(Army& army)
 
    cout << endl;
 
+   vector<Character*> suggestions;
+   if (character == nullptr) suggestions = suggestCharacters(army, attackerName);
+
    while (character == nullptr)
    {
-      cout << "You'll have to enter their name exactly... Try again: ";
+      if (suggestions.empty()) {
+         cout << "You'll have to enter their name exactly... Try again: ";
+      }
+      else {
+         cout << "Did you mean..." << endl;
+         for (int i = 0; unsigned(i) < suggestions.size(); i++) {
+            cout << "   " << i + 1 << ". " << suggestions[i]->getName() << endl;
+         }
+         cout << "Enter a number from the list, or a name: ";
+      }
 
       getline(cin, attackerName);
-      character = army.retrieve(attackerName);
+
+      //A number picks from the list, and the list stays up if it isn't on
+      //it. Anything else is looked up as a name.
+      bool isNumber = !attackerName.empty()
+         && attackerName.find_first_not_of("0123456789") == string::npos;
+      if (isNumber && !suggestions.empty()) {
+         unsigned long choice = (attackerName.size() <= 9) ? stoul(attackerName) : 0;
+         if (choice >= 1 && choice <= suggestions.size()) {
+            character = suggestions[choice - 1];
+         }
+         else {
+            cout << endl << attackerName << " isn't one of the listed choices." << endl;
+         }
+      }
+      else {
+         character = army.retrieve(attackerName);
+         if (character == nullptr) suggestions = suggestCharacters(army, attackerName);
+      }
 
       cout << endl;
    }
@@ -0,0 +1,79 @@
+/** @TestAnalyticPgf.cpp */
+
+/** Check program for AnalyticCombat::evaluateByPgf. For a spread of
+profiles, from a single attack up to horde-sized volleys, compares the
+damage distribution worked out through probability generating
+functions against the exact one built from failedSaveDistribution.
+Every probability must agree to within PGF_TOLERANCE, and damage that
+isn't a whole number of wounds must get no probability at all. Built as
+its own executable, like the other programs in tests/.
+
+Exits with 0 if every profile matches, 1 otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../AnalyticCombat.h"
+#include "../CombatProfile.h"
+#include "../DamageDistribution.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+
+const double PGF_TOLERANCE = 1e-12; //Largest difference allowed in any probability
+
+int main()
+{
+   //{hitStat, attacks, strength, ap, damage, toughness, armorSave, invulnSave, defenderWounds}
+   const CombatProfile PROFILES[] = {
+      { 3, 1, 4, 0, 1, 4, 3, 0, 1 },
+      { 4, 7, 5, 1, 2, 4, 4, 0, 3 },
+      { 2, 40, 8, 3, 3, 6, 3, 5, 12 },
+      { 3, 127, 4, 0, 1, 4, 5, 0, 20 },
+      { 3, 128, 4, 1, 1, 4, 3, 0, 20 },
+      { 5, 600, 3, 0, 2, 7, 2, 4, 40 },
+      { 4, 3000, 4, 1, 1, 4, 3, 0, 10 },
+   };
+
+   int failures = 0;
+
+   for (const CombatProfile& profile : PROFILES) {
+      //Exact distribution, spread over damage by hand.
+      vector<double> failedSaves = AnalyticCombat::failedSaveDistribution(profile);
+      vector<double> exact(failedSaves.size() * profile.damage - (profile.damage - 1), 0.0);
+      for (size_t wounds = 0; wounds < failedSaves.size(); wounds++) {
+         exact[wounds * profile.damage] = failedSaves[wounds];
+      }
+
+      DamageDistribution byPgf = AnalyticCombat::evaluateByPgf(profile);
+      const vector<double>& pgf = byPgf.probabilities();
+
+      double worst = 0;
+      bool offGrid = false;
+      for (size_t damage = 0; damage < max(exact.size(), pgf.size()); damage++) {
+         double expected = (damage < exact.size()) ? exact[damage] : 0.0;
+         double actual = (damage < pgf.size()) ? pgf[damage] : 0.0;
+         worst = max(worst, fabs(expected - actual));
+         if (damage % profile.damage != 0 && actual != 0.0) offGrid = true;
+      }
+
+      if (worst > PGF_TOLERANCE || offGrid) {
+         cout << profile.attacks << " attacks at D" << profile.damage << ": off by "
+            << worst << (offGrid ? ", with damage between whole wounds" : "") << endl;
+         failures++;
+      }
+
+      //Without asking for an approximation, evaluate() must stay exact.
+      if (AnalyticCombat::evaluate(profile).probabilities() != exact) {
+         cout << profile.attacks << " attacks at D" << profile.damage
+            << ": evaluate() isn't exact." << endl;
+         failures++;
+      }
+   }
+
+   cout << ((failures == 0) ? "PGF against the exact distribution: passed" :
+      "PGF against the exact distribution: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,283 @@
+/** @TestArmyNames.cpp */
+
+/** Check program for finding Characters by name in an Army. Builds
+armies of every size from empty to a few thousand, from made-up names
+that share many prefixes, and checks every lookup against a plain scan
+of getCharacters(): every name held must be found, names that aren't
+held must not be, and names added after a lookup must be found too.
+A second Character with a name already held must be turned away, and
+leave every lookup as it was.
+Lookups ignore case and surrounding whitespace, so each name is also
+looked up in a random mix of cases with spaces around it, and must
+then find a Character whose name differs from it only in those ways,
+or the one named exactly so if there is one.
+
+Completions and suggestions are checked against the scan too: complete()
+must return the first names in alphabetical order that start with the
+typed text, and suggest() the closest names within the edit distance
+allowed, closest first and alphabetical among equally close ones.
+Built as its own executable, like the other programs in tests/.
+
+Exits with 0 if every lookup matches the scan, 1 otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../Army.h"
+#include "../Character.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <random>
+#include <algorithm>
+#include <cctype>
+
+using namespace std;
+
+const int ARMY_SIZES[] = { 0, 1, 2, 3, 7, 8, 15, 16, 17, 100, 3000 };
+const int LOOKUPS = 300; //Lookups of names that aren't held, per army
+const int SEARCHES = 60; //Completions and suggestions, per army
+const int LIMIT = 5;     //Most names asked of each completion or suggestion
+
+/** Makes up a name from syllables that many names share.
+
+"generator" is the generator to draw from.
+
+Precondition: None.
+Postcondition: Returns a name of one to four syllables. */
+string madeUpName(mt19937& generator)
+{
+   const char* SYLLABLES[] = { "Kar", "gul", "Ith", "ron", "Vex", "ma", "Tor", "dak" };
+   string name;
+   int syllables = 1 + generator() % 4;
+   for (int i = 0; i < syllables; i++) name += SYLLABLES[generator() % 8];
+   return name;
+}
+
+/** Returns a name with surrounding whitespace removed and every
+letter in lower case.
+
+"name" is a name.
+
+Precondition: None.
+Postcondition: Returns the normalised name. */
+string normalised(const string& name)
+{
+   size_t first = name.find_first_not_of(" \t\r\n");
+   if (first == string::npos) return "";
+   size_t last = name.find_last_not_of(" \t\r\n");
+
+   string result = name.substr(first, last - first + 1);
+   for (char& letter : result) letter = (char)tolower((unsigned char)letter);
+   return result;
+}
+
+/** Returns a name in a random mix of cases, sometimes with spaces
+around it.
+
+"name" is a name.
+"generator" is the generator to draw from.
+
+Precondition: None.
+Postcondition: Returns the disguised name. */
+string disguised(const string& name, mt19937& generator)
+{
+   string result = name;
+   for (char& letter : result) {
+      letter = (generator() % 2) ? (char)toupper((unsigned char)letter) :
+         (char)tolower((unsigned char)letter);
+   }
+   if (generator() % 2) result = "  " + result + " ";
+   return result;
+}
+
+/** Checks one lookup against a scan of every Character.
+
+"characters" holds every Character in the Army.
+"name" is the name looked up.
+"found" is what the lookup returned.
+
+Precondition: None.
+Postcondition: Returns whether found is the Character with exactly
+that name, or failing that one whose normalised name matches, or
+nullptr if there is neither. */
+bool matchesScan(const vector<Character*>& characters, const string& name, Character* found)
+{
+   bool anyFolded = false;
+   for (Character* character : characters) {
+      if (character->getName() == name) return found == character;
+      if (normalised(character->getName()) == normalised(name)) anyFolded = true;
+   }
+
+   if (!anyFolded) return found == nullptr;
+   return found != nullptr && normalised(found->getName()) == normalised(name);
+}
+
+/** Returns the number of single letter insertions, deletions and
+substitutions that turn one name into another.
+
+"first" and "second" are names.
+
+Precondition: None.
+Postcondition: Returns an int. */
+int editDistance(const string& first, const string& second)
+{
+   vector<int> above(second.size() + 1);
+   vector<int> row(second.size() + 1);
+   for (size_t j = 0; j <= second.size(); j++) above[j] = (int)j;
+
+   for (size_t i = 1; i <= first.size(); i++) {
+      row[0] = (int)i;
+      for (size_t j = 1; j <= second.size(); j++) {
+         int substitute = above[j - 1] + ((first[i - 1] == second[j - 1]) ? 0 : 1);
+         row[j] = min(substitute, min(above[j] + 1, row[j - 1] + 1));
+      }
+      above.swap(row);
+   }
+   return above[second.size()];
+}
+
+/** Checks a completion against a scan of every Character.
+
+"characters" holds every Character in the Army.
+"prefix" is the text completed.
+"found" is what complete() returned.
+
+Precondition: None.
+Postcondition: Returns whether found holds, in order, the first LIMIT
+normalised names that start with the normalised prefix. */
+bool completesLikeScan(const vector<Character*>& characters, const string& prefix,
+   const vector<Character*>& found)
+{
+   string key = normalised(prefix);
+   vector<string> expected;
+   for (Character* character : characters) {
+      string name = normalised(character->getName());
+      if (name.compare(0, key.size(), key) == 0) expected.push_back(name);
+   }
+   sort(expected.begin(), expected.end());
+   if (expected.size() > (size_t)LIMIT) expected.resize(LIMIT);
+
+   vector<string> names;
+   for (Character* character : found) names.push_back(normalised(character->getName()));
+   return names == expected;
+}
+
+/** Checks a suggestion against a scan of every Character.
+
+"characters" holds every Character in the Army.
+"typed" is the name as typed.
+"maxDistance" is the most edits allowed.
+"found" is what suggest() returned.
+
+Precondition: None.
+Postcondition: Returns whether found holds, closest first and
+alphabetical among equals, the first LIMIT names within maxDistance. */
+bool suggestsLikeScan(const vector<Character*>& characters, const string& typed,
+   int maxDistance, const vector<Character*>& found)
+{
+   string target = normalised(typed);
+   vector<pair<int, string>> expected;
+   for (Character* character : characters) {
+      string name = normalised(character->getName());
+      int distance = editDistance(name, target);
+      if (distance <= maxDistance) expected.push_back(make_pair(distance, name));
+   }
+   sort(expected.begin(), expected.end());
+   if (expected.size() > (size_t)LIMIT) expected.resize(LIMIT);
+
+   vector<pair<int, string>> suggested;
+   for (Character* character : found) {
+      string name = normalised(character->getName());
+      suggested.push_back(make_pair(editDistance(name, target), name));
+   }
+   return suggested == expected;
+}
+
+int main()
+{
+   mt19937 generator(5);
+   int failures = 0;
+
+   //retrieve() reports misses on cout, which isn't what's being checked.
+   streambuf* console = cout.rdbuf(nullptr);
+
+   for (int size : ARMY_SIZES) {
+      Army army;
+      set<string> used;
+      while ((int)used.size() < size) {
+         string name = madeUpName(generator);
+         if (!used.insert(name).second) continue;
+         Character* character = new Character();
+         character->setName(name);
+         army.add(character);
+      }
+      vector<Character*> characters = army.getCharacters();
+
+      int wrong = 0;
+      for (Character* character : characters) {
+         if (army.retrieve(character->getName()) != character) wrong++;
+
+         string name = disguised(character->getName(), generator);
+         if (!matchesScan(characters, name, army.retrieve(name))) wrong++;
+      }
+      for (int i = 0; i < LOOKUPS; i++) {
+         string name = disguised(madeUpName(generator), generator);
+         if (!matchesScan(characters, name, army.retrieve(name))) wrong++;
+      }
+
+      for (int i = 0; i < SEARCHES; i++) {
+         //Part of a name that's held, or of one that likely isn't.
+         string name = (size > 0 && i % 2 == 0) ?
+            characters[generator() % characters.size()]->getName() : madeUpName(generator);
+         string prefix = disguised(name.substr(0, generator() % (name.size() + 1)), generator);
+         if (!completesLikeScan(characters, prefix, army.complete(prefix, LIMIT))) wrong++;
+
+         //The name with a letter changed and maybe one dropped.
+         string typed = name;
+         typed[generator() % typed.size()] = 'q';
+         if (generator() % 2) typed.erase(generator() % typed.size(), 1);
+         int maxDistance = generator() % 3;
+         if (!suggestsLikeScan(characters, typed, maxDistance,
+            army.suggest(typed, maxDistance, LIMIT))) {
+            wrong++;
+         }
+      }
+
+      //A name added after the lookups above must be found as well.
+      Character* late = new Character();
+      late->setName("Zz Late Arrival");
+      army.add(late);
+      if (army.retrieve("Zz Late Arrival") != late) wrong++;
+      if (army.retrieve(" zZ LATE arrival ") != late) wrong++;
+      vector<Character*> completed = army.complete("ZZ L", LIMIT);
+      if (completed.size() != 1 || completed[0] != late) wrong++;
+
+      //The same name again is refused; the same name in other case isn't.
+      Character* repeat = new Character();
+      repeat->setName("Zz Late Arrival");
+      if (army.add(repeat)) wrong++;
+      delete repeat;
+      Character* recased = new Character();
+      recased->setName("zz late arrival");
+      if (!army.add(recased)) wrong++;
+      if (army.retrieve("Zz Late Arrival") != late) wrong++;
+      if (army.retrieve("zz late arrival") != recased) wrong++;
+      completed = army.complete("zz late", LIMIT);
+      if (completed.size() != 2 || completed[0] != late || completed[1] != recased) wrong++;
+      if ((int)army.getCharacters().size() != size + 2) wrong++;
+
+      if (wrong > 0) {
+         cout.rdbuf(console);
+         cout << wrong << " searches in an army of " << size << " differ from a scan." << endl;
+         console = cout.rdbuf(nullptr);
+         failures++;
+      }
+   }
+
+   cout.rdbuf(console);
+   cout << ((failures == 0) ? "Army name searches against a scan: passed" :
+      "Army name searches against a scan: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+/** @TestBattleSimulator.cpp */
+
+/** Check program for BattleSimulator. Three things are checked:
+
+A one-turn battle between two lone fighters has an exact answer: the
+first side wins if its attack kills, the second if it survives that and
+its own attack kills, and otherwise it's a draw. Both sampling modes
+must land within Z_SCORE standard errors of those chances, worked out
+from AnalyticCombat.
+
+A battle between the armies in characters.txt must give exactly the
+same report on 1, 3 and 8 threads, since battle i is always seeded by
+its index.
+
+Every report must add up: the win and draw rates sum to 1, attrition
+starts at the size of each army, never rises, and ends at the mean
+number of survivors.
+
+Run it from the main folder, where characters.txt is. Built as its own
+executable, like the other programs in tests/.
+
+Exits with 0 if every check passes, 1 otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../BattleSimulator.h"
+#include "../AnalyticCombat.h"
+#include "../Army.h"
+#include "../Character.h"
+#include "../CombatProfile.h"
+#include "../CombatRules.h"
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+const long long BATTLES = 100000;
+const double Z_SCORE = 4.0;
+const uint64_t SEED = 11;
+
+/** Checks one estimate against its exact value.
+
+"what" names the estimate in the report.
+"estimate" is the sampled value.
+"exact" is the exact chance.
+
+Precondition: None.
+Postcondition: Returns whether the estimate is within Z_SCORE standard
+errors of the exact chance, and reports it if not. */
+bool withinInterval(const char* what, double estimate, double exact)
+{
+   double halfWidth = Z_SCORE * sqrt(exact * (1 - exact) / BATTLES);
+   if (fabs(estimate - exact) <= halfWidth) return true;
+
+   cout << what << ": sampled " << estimate << ", exact " << exact
+      << ", allowed +/- " << halfWidth << endl;
+   return false;
+}
+
+/** Checks that a report adds up.
+
+"report" is the report to check.
+"sizes" holds the number of units on each side.
+
+Precondition: None.
+Postcondition: Returns whether the report is consistent, and reports
+what isn't if not. */
+bool consistent(const BattleReport& report, const int sizes[2])
+{
+   bool passed = true;
+   if (fabs(report.winRate[0] + report.winRate[1] + report.drawRate - 1) > 1e-9) {
+      cout << "Win and draw rates don't add up to 1." << endl;
+      passed = false;
+   }
+   for (int side = 0; side < 2; side++) {
+      const vector<double>& attrition = report.attrition[side];
+      if (attrition.empty() || attrition[0] != sizes[side]) {
+         cout << "Side " << side << " doesn't start at full strength." << endl;
+         passed = false;
+         continue;
+      }
+      for (size_t turn = 1; turn < attrition.size(); turn++) {
+         if (attrition[turn] > attrition[turn - 1] + 1e-9) {
+            cout << "Side " << side << " gains units in turn " << turn << "." << endl;
+            passed = false;
+         }
+      }
+      if (fabs(attrition.back() - report.meanSurvivors[side]) > 1e-9) {
+         cout << "Side " << side << "'s attrition doesn't end at its survivors." << endl;
+         passed = false;
+      }
+   }
+   return passed;
+}
+
+/** Returns whether two reports are exactly the same. */
+bool sameReport(const BattleReport& first, const BattleReport& second)
+{
+   return first.battles == second.battles && first.drawRate == second.drawRate &&
+      first.winRate[0] == second.winRate[0] && first.winRate[1] == second.winRate[1] &&
+      first.meanSurvivors[0] == second.meanSurvivors[0] &&
+      first.meanSurvivors[1] == second.meanSurvivors[1] &&
+      first.attrition[0] == second.attrition[0] && first.attrition[1] == second.attrition[1];
+}
+
+int main()
+{
+   int failures = 0;
+
+   //Two lone fighters, with nothing but a melee weapon each.
+   Army firstArmy;
+   Army secondArmy;
+   Character* first = new Character();
+   first->setName("First");
+   first->setStats("6 3 3 4 4 2 4 7 3 0");
+   first->setMeleeNew("Blade 5 -1 2 None");
+   firstArmy.add(first);
+   Character* second = new Character();
+   second->setName("Second");
+   second->setStats("6 3 4 4 4 2 3 7 4 5");
+   second->setMeleeNew("Axe 5 -2 2 None");
+   secondArmy.add(second);
+
+   CombatProfile firstAttack = first->meleeProfile(*second, first->getMeleeAt(0));
+   CombatProfile secondAttack = second->meleeProfile(*first, second->getMeleeAt(0));
+   double firstKills = AnalyticCombat::evaluate(firstAttack).killProbability(
+      firstAttack.defenderWounds);
+   double secondKills = AnalyticCombat::evaluate(secondAttack).killProbability(
+      secondAttack.defenderWounds);
+
+   const SamplingMode MODES[] = { DIE_BY_DIE, BINOMIAL };
+   const int LONE[2] = { 1, 1 };
+   for (SamplingMode mode : MODES) {
+      BattleSimulator simulator(firstArmy, secondArmy);
+      simulator.setSamplingMode(mode);
+      BattleReport report = simulator.run(BATTLES, 1, SEED);
+
+      bool passed = withinInterval("First side wins", report.winRate[0], firstKills);
+      passed = withinInterval("Second side wins", report.winRate[1],
+         (1 - firstKills) * secondKills) && passed;
+      passed = consistent(report, LONE) && passed;
+      if (!passed) {
+         cout << "   in a one-turn duel, "
+            << ((mode == BINOMIAL) ? "binomial sampling" : "die by die") << endl;
+         failures++;
+      }
+   }
+
+   //The shipped roster against itself, on several thread counts.
+   Army roster("characters.txt");
+   if (roster.numCharacters() == 0) {
+      cout << "Run this from the folder holding characters.txt." << endl;
+      return 1;
+   }
+   const int SIZES[2] = { roster.numCharacters(), roster.numCharacters() };
+   const int THREADS[] = { 1, 3, 8 };
+
+   BattleReport reference;
+   for (int threads : THREADS) {
+      BattleSimulator simulator(roster, roster, threads);
+      BattleReport report = simulator.run(BATTLES / 10, 10, SEED);
+
+      bool passed = consistent(report, SIZES);
+      if (threads == THREADS[0]) {
+         reference = report;
+      }
+      else if (!sameReport(report, reference)) {
+         cout << "The report differs from the one on " << THREADS[0] << " thread." << endl;
+         passed = false;
+      }
+      if (!passed) {
+         cout << "   for the roster on " << threads << " threads" << endl;
+         failures++;
+      }
+   }
+
+   cout << ((failures == 0) ? "BattleSimulator: passed" : "BattleSimulator: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}
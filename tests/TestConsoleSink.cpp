@@ -0,0 +1,112 @@
+/** @TestConsoleSink.cpp */
+
+/** Check program for ConsoleSink. Replays a fixed set of fights
+between the units in characters.txt, from a fixed seed, in both
+sampling modes, and checks that what combat prints is exactly the
+transcript in ConsoleTranscript.txt. That transcript was captured from
+Character::combat as it was before combat reported through event
+sinks, when it printed straight to cout, so this checks that routing
+the fight through ConsoleSink didn't change a single character of the
+output. It's checked twice: once through the default sink, writing to
+cout, and once through a ConsoleSink writing to a string.
+
+Run it from the main folder, where characters.txt is. Built as its own
+executable, like the other programs in tests/.
+
+Exits with 0 if both transcripts match, 1 otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../Army.h"
+#include "../Character.h"
+#include "../CombatRules.h"
+#include "../ConsoleSink.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+const char* TRANSCRIPT_FILE = "tests/ConsoleTranscript.txt";
+const unsigned long long SEED = 2026;
+const int ROUNDS = 2; //Times each Character attacks per sampling mode
+
+/** Plays the fixed set of fights.
+
+"sink" is the sink every Character reports to, or nullptr to keep the
+default one.
+
+Precondition: characters.txt must be readable.
+Postcondition: Every fight has been played and reported. */
+void playFights(CombatEventSink* sink)
+{
+   const SamplingMode MODES[] = { DIE_BY_DIE, BINOMIAL };
+   Character::seedDice(SEED);
+
+   for (SamplingMode mode : MODES) {
+      Army army("characters.txt");
+      vector<Character*> characters = army.getCharacters();
+      for (Character* character : characters) {
+         if (sink != nullptr) character->setEventSink(sink);
+         character->setSamplingMode(mode);
+      }
+
+      for (int round = 0; round < ROUNDS; round++) {
+         for (size_t i = 0; i < characters.size(); i++) {
+            Character* attacker = characters[i];
+            Character* defender = characters[(i + 1 + round) % characters.size()];
+            if (attacker->numMeleeWeapons() > 0) {
+               attacker->meleeAttack(*defender, attacker->getMeleeAt(0));
+            }
+            if (attacker->numRangedWeapons() > 0) {
+               attacker->rangedAttack(*defender, attacker->getRangedAt(0));
+            }
+         }
+      }
+
+      for (Character* character : characters) {
+         character->setEventSink(nullptr);
+      }
+   }
+}
+
+int main()
+{
+   ifstream file(TRANSCRIPT_FILE);
+   if (!file) {
+      cout << "Run this from the main folder, where " << TRANSCRIPT_FILE << " is." << endl;
+      return 1;
+   }
+   stringstream expected;
+   expected << file.rdbuf();
+
+   //Through the default sink, which prints to cout.
+   ostringstream printed;
+   streambuf* console = cout.rdbuf(printed.rdbuf());
+   playFights(nullptr);
+   cout.rdbuf(console);
+
+   //Through a ConsoleSink of our own.
+   ostringstream written;
+   ConsoleSink sink(written);
+   streambuf* quiet = cout.rdbuf(nullptr);
+   playFights(&sink);
+   cout.rdbuf(quiet);
+
+   int failures = 0;
+   if (printed.str() != expected.str()) {
+      cout << "The default sink's transcript differs from " << TRANSCRIPT_FILE << "." << endl;
+      failures++;
+   }
+   if (written.str() != expected.str()) {
+      cout << "A ConsoleSink's transcript differs from " << TRANSCRIPT_FILE << "." << endl;
+      failures++;
+   }
+
+   cout << ((failures == 0) ? "ConsoleSink against the original transcript: passed" :
+      "ConsoleSink against the original transcript: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}
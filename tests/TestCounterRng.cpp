@@ -0,0 +1,89 @@
+/** @TestCounterRng.cpp */
+
+/** Check program for CounterRng. Positions the generator on the counter
+and key of each known-answer vector published with Philox4x32-10 by
+Salmon et al. (Random123, kat_vectors) and compares the block it
+produces, word for word. Built as its own executable, like the other
+programs in tests/.
+
+Exits with 0 if every vector matches, 1 otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../CounterRng.h"
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+
+using namespace std;
+
+/** One known answer: the generator's counter, its key, and the block
+Philox4x32-10 encrypts them to. */
+struct KnownAnswer
+{
+   uint32_t counter[4];
+   uint32_t key[2];
+   uint32_t block[4];
+};
+
+const KnownAnswer KNOWN_ANSWERS[] = {
+   { { 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u },
+     { 0x00000000u, 0x00000000u },
+     { 0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u } },
+   { { 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu },
+     { 0xffffffffu, 0xffffffffu },
+     { 0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu } },
+   { { 0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u },
+     { 0xa4093822u, 0x299f31d0u },
+     { 0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u } },
+};
+
+/** Moves a generator to the start of the given block. discard() counts
+in words, so a far block is reached in several skips.
+
+"rng" is a generator at the start of its stream.
+"block" is the block position to move to.
+
+Precondition: rng must be at the start of its stream.
+Postcondition: The next output is the first word of that block. */
+void seekBlock(CounterRng& rng, uint64_t block)
+{
+   const uint64_t MAX_SKIP = UINT64_MAX / 4; //Blocks per discard()
+   while (block > 0) {
+      uint64_t skip = (block < MAX_SKIP) ? block : MAX_SKIP;
+      rng.discard(skip * 4);
+      block -= skip;
+   }
+}
+
+int main()
+{
+   int failures = 0;
+
+   for (const KnownAnswer& answer : KNOWN_ANSWERS) {
+      //The key is the seed. The first two counter words are the block
+      //position and the last two are the stream.
+      uint64_t seed = (uint64_t)answer.key[1] << 32 | answer.key[0];
+      uint64_t stream = (uint64_t)answer.counter[3] << 32 | answer.counter[2];
+      uint64_t block = (uint64_t)answer.counter[1] << 32 | answer.counter[0];
+
+      CounterRng rng(seed, stream);
+      seekBlock(rng, block);
+
+      for (int i = 0; i < 4; i++) {
+         uint32_t word = rng();
+         if (word != answer.block[i]) {
+            cout << hex << setfill('0') << "Key " << setw(8) << answer.key[1]
+               << setw(8) << answer.key[0] << ", word " << i << ": expected "
+               << setw(8) << answer.block[i] << ", got " << setw(8) << word
+               << dec << endl;
+            failures++;
+         }
+      }
+   }
+
+   cout << ((failures == 0) ? "Philox4x32-10 known answers: passed" :
+      "Philox4x32-10 known answers: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}
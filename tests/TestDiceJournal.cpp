@@ -0,0 +1,213 @@
+/** @TestDiceJournal.cpp */
+
+/** Check program for DiceJournal and JournalReplay. Plays the roster
+in characters.txt against itself over several sessions appended to
+one journal, the last in BINOMIAL mode, printing each fight to a
+ConsoleSink as it's recorded. Then replays the journal and checks that
+every fight is there, that replayAll() finds no fight whose results
+don't match its dice, and that the replayed transcript is the same,
+character for character, as the one printed live. Finally records two
+fights by hand, each with a stage of no dice and two successes, and
+checks that the rolled one is caught and the drawn one isn't. Run it from the main
+folder, where characters.txt is. Built as its own executable, like the
+other programs in tests/.
+
+Exits with 0 if the journal replays exactly, 1 otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../Army.h"
+#include "../Character.h"
+#include "../CombatEventSink.h"
+#include "../CombatRules.h"
+#include "../ConsoleSink.h"
+#include "../DiceJournal.h"
+#include "../JournalReplay.h"
+#include "../NullSink.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+using namespace std;
+
+const char* JOURNAL_FILE = "TestDiceJournal.bin";
+const char* EMPTY_STAGE_FILE = "TestDiceJournalEmpty.bin";
+const int SESSIONS = 3; //The last one samples binomially
+const int ROUNDS = 20;  //Times each Character attacks per session
+
+/** Passes every event on to two sinks, so a fight can be recorded and
+printed at once, and counts the fights. */
+class TeeSink : public CombatEventSink
+{
+private:
+   CombatEventSink& first_;
+   CombatEventSink& second_;
+   int fights_;
+
+public:
+   TeeSink(CombatEventSink& first, CombatEventSink& second)
+      : first_(first), second_(second), fights_(0)
+   {
+   }
+
+   int fights() const { return fights_; }
+
+   virtual bool wantsRolls() const
+   {
+      return first_.wantsRolls() || second_.wantsRolls();
+   }
+
+   virtual void fightSkipped(bool attackerDead)
+   {
+      fights_++;
+      first_.fightSkipped(attackerDead);
+      second_.fightSkipped(attackerDead);
+   }
+
+   virtual void fightStarted(const string& stat, int hitStat, int damage)
+   {
+      fights_++;
+      first_.fightStarted(stat, hitStat, damage);
+      second_.fightStarted(stat, hitStat, damage);
+   }
+
+   virtual void stageStarted(CombatStage stage, int threshold)
+   {
+      first_.stageStarted(stage, threshold);
+      second_.stageStarted(stage, threshold);
+   }
+
+   virtual void dieRolled(CombatStage stage, int roll)
+   {
+      first_.dieRolled(stage, roll);
+      second_.dieRolled(stage, roll);
+   }
+
+   virtual void stageDrawn(CombatStage stage, int count)
+   {
+      first_.stageDrawn(stage, count);
+      second_.stageDrawn(stage, count);
+   }
+
+   virtual void stageFinished(CombatStage stage, int result)
+   {
+      first_.stageFinished(stage, result);
+      second_.stageFinished(stage, result);
+   }
+
+   virtual void fightFinished(int damage, int woundsLeft)
+   {
+      first_.fightFinished(damage, woundsLeft);
+      second_.fightFinished(damage, woundsLeft);
+   }
+};
+
+int main()
+{
+   remove(JOURNAL_FILE);
+
+   ostringstream live;
+   int recorded = 0;
+
+   for (int session = 0; session < SESSIONS; session++) {
+      Army army("characters.txt");
+      vector<Character*> characters = army.getCharacters();
+      if (characters.size() < 2) {
+         cout << "Run this from the folder holding characters.txt." << endl;
+         return 1;
+      }
+
+      DiceJournal journal(JOURNAL_FILE);
+      if (!journal.isOpen()) {
+         cout << "Couldn't open " << JOURNAL_FILE << " for recording." << endl;
+         return 1;
+      }
+      ConsoleSink console(live);
+      TeeSink tee(journal, console);
+
+      for (Character* character : characters) {
+         character->setEventSink(&tee);
+         if (session == SESSIONS - 1) character->setSamplingMode(BINOMIAL);
+      }
+
+      for (int round = 0; round < ROUNDS; round++) {
+         for (size_t i = 0; i < characters.size(); i++) {
+            Character* attacker = characters[i];
+            Character* defender = characters[(i + 1 + round) % characters.size()];
+            if (attacker == defender) continue;
+            if (attacker->numMeleeWeapons() > 0) {
+               attacker->meleeAttack(*defender, attacker->getMeleeAt(0));
+            }
+            if (attacker->numRangedWeapons() > 0) {
+               attacker->rangedAttack(*defender, attacker->getRangedAt(0));
+            }
+         }
+      }
+
+      for (Character* character : characters) {
+         character->setEventSink(nullptr);
+      }
+      recorded += tee.fights();
+   }
+
+   int failures = 0;
+   {
+      JournalReplay replay(JOURNAL_FILE);
+      if (!replay.isOpen()) {
+         cout << "Couldn't read back " << JOURNAL_FILE << "." << endl;
+         failures++;
+      }
+      else {
+         ostringstream replayed;
+         ConsoleSink console(replayed);
+         int mismatches = replay.replayAll(console);
+
+         if (replay.numFights() != recorded) {
+            cout << recorded << " fights were recorded, but the journal holds "
+               << replay.numFights() << "." << endl;
+            failures++;
+         }
+         if (mismatches != 0) {
+            cout << mismatches << " fights don't match their recorded dice." << endl;
+            failures++;
+         }
+         if (replayed.str() != live.str()) {
+            cout << "The replayed transcript differs from the live one." << endl;
+            failures++;
+         }
+      }
+   }
+   remove(JOURNAL_FILE);
+
+   //A stage that rolled no dice but claims successes must not pass for
+   //one drawn binomially.
+   remove(EMPTY_STAGE_FILE);
+   {
+      DiceJournal journal(EMPTY_STAGE_FILE);
+      for (int drawn = 0; drawn < 2; drawn++) {
+         journal.fightStarted("WS", 3, 1);
+         journal.stageStarted(HIT_STAGE, 3);
+         if (drawn == 1) journal.stageDrawn(HIT_STAGE, 3);
+         journal.stageFinished(HIT_STAGE, 2);
+         journal.fightFinished(0, 1);
+      }
+   }
+   {
+      JournalReplay replay(EMPTY_STAGE_FILE);
+      NullSink sink;
+      if (replay.numFights() != 2 || replay.replayFight(0, sink)
+         || !replay.replayFight(1, sink)) {
+         cout << "A stage with no dice was taken for a drawn one, or the "
+            << "other way round." << endl;
+         failures++;
+      }
+   }
+   remove(EMPTY_STAGE_FILE);
+
+   cout << ((failures == 0) ? "Dice journal round trip: passed" :
+      "Dice journal round trip: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}
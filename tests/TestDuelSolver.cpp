@@ -0,0 +1,132 @@
+/** @TestDuelSolver.cpp */
+
+/** Check program for DuelSolver. Plays each duel out many times with
+real dice, through the same MonteCarlo::rollAttack the engines use,
+and checks that the share of duels each side wins, and the mean length
+of a duel, land within Z_SCORE standard errors of what the solver
+works out exactly. Also checks that a duel where neither side can hurt
+the other is reported as undecided. Built as its own executable, like
+the other programs in tests/.
+
+Exits with 0 if every duel matches, 1 otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../DuelSolver.h"
+#include "../MonteCarlo.h"
+#include "../CombatProfile.h"
+#include "../CombatRules.h"
+#include "../CounterRng.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+const long long DUELS = 200000;
+const double Z_SCORE = 4.0;
+const uint64_t SEED = 9;
+
+/** Checks one estimate against its exact value.
+
+"what" names the estimate in the report.
+"estimate" is the sampled value.
+"exact" is the exact value.
+"variance" is the variance of one duel.
+
+Precondition: None.
+Postcondition: Returns whether the estimate is within Z_SCORE standard
+errors of the exact value, and reports it if not. */
+bool withinInterval(const char* what, double estimate, double exact, double variance)
+{
+   double halfWidth = Z_SCORE * sqrt(variance / DUELS);
+   if (fabs(estimate - exact) <= halfWidth) return true;
+
+   cout << what << ": sampled " << estimate << ", exact " << exact
+      << ", allowed +/- " << halfWidth << endl;
+   return false;
+}
+
+int main()
+{
+   //{hitStat, attacks, strength, ap, damage, toughness, armorSave, invulnSave, defenderWounds}
+   //Each pair is the first side's attack on the second, then the reply.
+   const CombatProfile DUELISTS[][2] = {
+      { { 3, 4, 5, 1, 2, 4, 3, 0, 10 }, { 4, 3, 4, 0, 1, 4, 4, 5, 8 } },
+      { { 2, 6, 4, 0, 1, 4, 3, 0, 5 }, { 2, 6, 4, 0, 1, 4, 3, 0, 5 } },
+      { { 4, 1, 8, 3, 6, 3, 5, 0, 4 }, { 3, 5, 3, 0, 1, 8, 2, 4, 12 } },
+   };
+
+   int failures = 0;
+   vector<uint8_t> dice;
+
+   for (const auto& duelists : DUELISTS) {
+      const CombatProfile& first = duelists[0];
+      const CombatProfile& second = duelists[1];
+      DuelResult exact = DuelSolver(first, second).solve();
+
+      int firstWound = woundRoll(first.strength, first.toughness);
+      int firstSave = bestSave(first.armorSave, first.invulnSave, first.ap);
+      int secondWound = woundRoll(second.strength, second.toughness);
+      int secondSave = bestSave(second.armorSave, second.invulnSave, second.ap);
+
+      //Each duel gets its own stream, as MonteCarlo's trials do.
+      long long firstWins = 0;
+      double rounds = 0;
+      double roundsSquared = 0;
+      for (long long duel = 0; duel < DUELS; duel++) {
+         CounterRng rng(SEED, duel);
+         int firstWounds = second.defenderWounds;
+         int secondWounds = first.defenderWounds;
+         int round = 0;
+         while (true) {
+            round++;
+            secondWounds -= MonteCarlo::rollAttack(first, firstWound, firstSave, rng,
+               DIE_BY_DIE, dice);
+            if (secondWounds <= 0) {
+               firstWins++;
+               break;
+            }
+            firstWounds -= MonteCarlo::rollAttack(second, secondWound, secondSave, rng,
+               DIE_BY_DIE, dice);
+            if (firstWounds <= 0) break;
+         }
+         rounds += round;
+         roundsSquared += (double)round * round;
+      }
+
+      double share = (double)firstWins / DUELS;
+      double meanRounds = rounds / DUELS;
+      double roundsVariance = roundsSquared / DUELS - meanRounds * meanRounds;
+
+      bool passed = withinInterval("First side wins", share, exact.firstWins,
+         exact.firstWins * (1 - exact.firstWins));
+      passed = withinInterval("Mean rounds", meanRounds, exact.expectedRounds,
+         roundsVariance) && passed;
+      if (exact.undecided > 1e-9) {
+         cout << "The solver left " << exact.undecided << " undecided." << endl;
+         passed = false;
+      }
+
+      if (!passed) {
+         cout << "   for " << first.attacks << " attacks at D" << first.damage << " against "
+            << second.attacks << " attacks at D" << second.damage << endl;
+         failures++;
+      }
+   }
+
+   //Neither side can hit, so no round decides anything.
+   CombatProfile harmless = { 7, 4, 5, 1, 2, 4, 3, 0, 10 };
+   DuelResult stalemate = DuelSolver(harmless, harmless).solve(50);
+   if (stalemate.undecided != 1 || stalemate.firstWins != 0 || stalemate.secondWins != 0) {
+      cout << "A duel nobody can win was reported as " << stalemate.undecided
+         << " undecided." << endl;
+      failures++;
+   }
+
+   cout << ((failures == 0) ? "DuelSolver against sampled duels: passed" :
+      "DuelSolver against sampled duels: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}
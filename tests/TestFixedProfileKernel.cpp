@@ -0,0 +1,92 @@
+/** @TestFixedProfileKernel.cpp */
+
+/** Check program for FixedProfileKernel. For every damage, AP and
+attack count over a range wider than the specialised grid, and a
+spread of hit, wound and save rolls, looks the profile up with find()
+and checks that a kernel is returned exactly for the profiles inside
+the grid. Wherever one is returned, runs it side by side with
+MonteCarlo::rollAttack in DIE_BY_DIE mode on identically seeded
+generators, and checks that every trial does the same damage and leaves
+both generators at the same place. Built as its own executable, like
+the other programs in tests/.
+
+Exits with 0 if every kernel matches the generic path, 1 otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../FixedProfileKernel.h"
+#include "../MonteCarlo.h"
+#include "../CombatProfile.h"
+#include "../CombatRules.h"
+#include "../CounterRng.h"
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+const int MAX_TRIED = 12; //Widest damage, AP and attacks tried
+const int TRIALS = 2000;       //Trials per profile
+const uint64_t SEED = 5;
+
+int main()
+{
+   //{hitStat, toughness, armorSave, invulnSave}, with strength 4
+   const int DEFENCES[][4] = { { 3, 4, 3, 0 }, { 2, 8, 2, 4 }, { 5, 3, 6, 0 }, { 4, 2, 7, 5 } };
+
+   int failures = 0;
+   int kernels = 0;
+   vector<uint8_t> dice;
+
+   for (int damage = 0; damage <= MAX_TRIED; damage++) {
+      for (int ap = 0; ap <= MAX_TRIED; ap++) {
+         for (int attacks = 0; attacks <= MAX_TRIED; attacks++) {
+            for (const int* defence : DEFENCES) {
+               CombatProfile profile = { defence[0], attacks, 4, ap, damage, defence[1],
+                  defence[2], defence[3], 1 };
+               FixedProfileKernel::Function kernel = FixedProfileKernel::find(profile);
+               bool inGrid = damage >= 1 && damage <= FIXED_MAX_DAMAGE && ap <= FIXED_MAX_AP
+                  && attacks >= 1 && attacks <= FIXED_MAX_ATTACKS;
+               if ((kernel != nullptr) != inGrid) {
+                  cout << "D" << damage << " AP" << ap << " with " << attacks
+                     << " attacks " << (inGrid ? "has no kernel." : "has a kernel.") << endl;
+                  failures++;
+               }
+               if (kernel == nullptr) continue;
+               kernels++;
+
+               int toWound = woundRoll(profile.strength, profile.toughness);
+               int saveRoll = bestSave(profile.armorSave, profile.invulnSave, profile.ap);
+               CounterRng specialised(SEED, kernels);
+               CounterRng generic(SEED, kernels);
+
+               for (int trial = 0; trial < TRIALS; trial++) {
+                  int expected = MonteCarlo::rollAttack(profile, toWound, saveRoll, generic,
+                     DIE_BY_DIE, dice);
+                  if (kernel(profile, specialised) != expected) {
+                     cout << "D" << damage << " AP" << ap << " with " << attacks
+                        << " attacks differs in trial " << trial << "." << endl;
+                     failures++;
+                     break;
+                  }
+               }
+               if (specialised() != generic()) {
+                  cout << "D" << damage << " AP" << ap << " with " << attacks
+                     << " attacks leaves the generator elsewhere." << endl;
+                  failures++;
+               }
+            }
+         }
+      }
+   }
+
+   if (kernels == 0) {
+      cout << "find() returned no kernels at all." << endl;
+      failures++;
+   }
+
+   cout << ((failures == 0) ? "Specialised kernels against the generic path: passed" :
+      "Specialised kernels against the generic path: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}
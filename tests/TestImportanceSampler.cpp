@@ -0,0 +1,90 @@
+/** @TestImportanceSampler.cpp */
+
+/** Check program for ImportanceSampler. For matchups where a kill is
+rare, and one where it isn't, runs the sampler under many seeds and
+checks that the estimates average out to the exact kill probability
+from AnalyticCombat: the mean of the estimates must be within Z_SCORE
+standard errors of it, the standard error being taken from how much
+the estimates spread. A biased likelihood ratio shows up as the mean
+drifting away however many seeds are run. Also checks that only the
+rare matchups were tilted, and that a negative number of attacks
+counts as none. Built as its own executable, like the other programs
+in tests/.
+
+Exits with 0 if every matchup averages out to its exact value, 1
+otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../ImportanceSampler.h"
+#include "../AnalyticCombat.h"
+#include "../CombatProfile.h"
+#include "../DamageDistribution.h"
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+
+const int SEEDS = 40;            //Independent estimates per matchup
+const long long TRIALS = 20000;  //Trials per estimate
+const double Z_SCORE = 4.0;
+
+int main()
+{
+   //{hitStat, attacks, strength, ap, damage, toughness, armorSave, invulnSave, defenderWounds}
+   const CombatProfile RARE[] = {
+      { 3, 10, 8, 2, 2, 6, 3, 5, 15 },
+      { 3, 20, 4, 0, 1, 6, 3, 5, 15 },
+      { 2, 6, 9, 3, 3, 6, 3, 5, 15 },
+   };
+   const CombatProfile COMMON = { 2, 10, 8, 1, 1, 4, 5, 0, 2 };
+
+   int failures = 0;
+
+   for (int i = 0; i < 4; i++) {
+      const CombatProfile& profile = (i < 3) ? RARE[i] : COMMON;
+      double exact = AnalyticCombat::evaluate(profile).killProbability(profile.defenderWounds);
+
+      double sum = 0;
+      double sumSquares = 0;
+      bool tilted = false;
+      for (int seed = 1; seed <= SEEDS; seed++) {
+         ImportanceSampler sampler(seed);
+         RareEventEstimate estimate = sampler.killProbability(profile, TRIALS);
+         sum += estimate.probability;
+         sumSquares += estimate.probability * estimate.probability;
+         if (estimate.tilt != 0) tilted = true;
+      }
+
+      double mean = sum / SEEDS;
+      double spread = (sumSquares - sum * mean) / (SEEDS - 1);
+      double standardError = sqrt((spread > 0) ? spread / SEEDS : 0);
+
+      if (fabs(mean - exact) > Z_SCORE * standardError + 1e-15) {
+         cout << profile.attacks << " attacks at D" << profile.damage << " into "
+            << profile.defenderWounds << " wounds: averaged " << mean << ", exact "
+            << exact << ", standard error " << standardError << endl;
+         failures++;
+      }
+      if (tilted != (i < 3)) {
+         cout << profile.attacks << " attacks at D" << profile.damage << " into "
+            << profile.defenderWounds << " wounds: a kill chance of " << exact
+            << (tilted ? " was" : " wasn't") << " tilted." << endl;
+         failures++;
+      }
+   }
+
+   //No attacks can't kill a defender with wounds left.
+   const CombatProfile NEGATIVE = { 3, -5, 4, 0, 1, 4, 3, 0, 1 };
+   ImportanceSampler sampler(1);
+   RareEventEstimate estimate = sampler.killProbability(NEGATIVE, TRIALS);
+   if (estimate.probability != 0 || estimate.tilt != 0) {
+      cout << "-5 attacks killed with probability " << estimate.probability << "." << endl;
+      failures++;
+   }
+
+   cout << ((failures == 0) ? "Importance sampling against the exact results: passed" :
+      "Importance sampling against the exact results: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}
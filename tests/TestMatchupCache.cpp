@@ -0,0 +1,161 @@
+/** @TestMatchupCache.cpp */
+
+/** Check program for MatchupCache. Builds every profile over a grid of
+characteristics, attack counts and damage values and checks that two
+profiles share a key only when the chances that decide their damage
+distribution (to hit, to wound and to fail the save) and their attacks
+and damage are all the same, so no two different matchups can ever be
+handed each other's distribution. The grid runs up to the largest
+attacks and damage a key holds. Then checks that get() returns what
+AnalyticCombat works out, counts its hits and misses, stays within its
+capacity, never stores a profile whose damage is too large to key, and
+turns away one too large to evaluate at all. Built as its own executable, like the other programs in
+tests/.
+
+Exits with 0 if every check passes, 1 otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../MatchupCache.h"
+#include "../AnalyticCombat.h"
+#include "../CombatProfile.h"
+#include "../CombatRules.h"
+#include "../DamageDistribution.h"
+#include <iostream>
+#include <map>
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <climits>
+
+using namespace std;
+
+/** What decides a profile's damage distribution: the chances to hit,
+to wound and to fail the save, the attacks and the damage. */
+typedef tuple<double, double, double, int, int> Outcome;
+
+/** Returns what decides a profile's damage distribution.
+
+"profile" is a CombatProfile.
+
+Precondition: None.
+Postcondition: Returns an Outcome. Two profiles with the same Outcome
+have the same damage distribution. */
+Outcome outcomeOf(const CombatProfile& profile)
+{
+   return Outcome(chanceAtLeast(profile.hitStat),
+      chanceAtLeast(woundRoll(profile.strength, profile.toughness)),
+      1 - chanceAtLeast(bestSave(profile.armorSave, profile.invulnSave, profile.ap)),
+      (profile.attacks > 0) ? profile.attacks : 0,
+      (profile.damage > 0) ? profile.damage : 0);
+}
+
+int main()
+{
+   const int ATTACKS[] = { 0, 1, 2, 3, 7, 40, 1000, INT_MAX };
+   const int DAMAGE[] = { 0, 1, 2, 3, 6, 256, 1000, 65536, 65537, 0xFFFFFF };
+
+   vector<CombatProfile> profiles;
+   for (int hit = 1; hit <= 7; hit++)
+      for (int strength = 1; strength <= 10; strength += 3)
+         for (int toughness = 1; toughness <= 10; toughness += 3)
+            for (int armorSave = 2; armorSave <= 7; armorSave++)
+               for (int invulnSave = 0; invulnSave <= 6; invulnSave += 2)
+                  for (int ap = -3; ap <= 0; ap++)
+                     for (int attacks : ATTACKS)
+                        for (int damage : DAMAGE) {
+                           profiles.push_back({ hit, attacks, strength, ap, damage,
+                              toughness, armorSave, invulnSave, 1 });
+                        }
+
+   int failures = 0;
+
+   //Every key must stand for exactly one outcome.
+   map<uint64_t, Outcome> outcomes;
+   for (const CombatProfile& profile : profiles) {
+      if (!MatchupCache::cacheable(profile)) {
+         cout << "A profile at D" << profile.damage << " isn't cacheable." << endl;
+         failures++;
+         continue;
+      }
+      uint64_t key = MatchupCache::key(profile);
+      auto found = outcomes.find(key);
+      if (found == outcomes.end()) {
+         outcomes[key] = outcomeOf(profile);
+      }
+      else if (found->second != outcomeOf(profile)) {
+         if (failures < 10) {
+            cout << "Key " << key << " is shared by profiles with " << profile.attacks
+               << " attacks at D" << profile.damage << " and "
+               << get<3>(found->second) << " attacks at D" << get<4>(found->second)
+               << " that don't play out alike." << endl;
+         }
+         failures++;
+      }
+   }
+
+   //A small cache must solve what it misses and keep what it hits.
+   MatchupCache cache(64);
+   const CombatProfile PROFILES[] = {
+      { 3, 4, 4, 0, 1, 4, 3, 0, 2 },
+      { 4, 10, 8, -2, 2, 6, 3, 5, 6 },
+      { 2, 6, 9, -3, 3, 6, 3, 5, 15 },
+   };
+   for (int pass = 0; pass < 2; pass++) {
+      for (const CombatProfile& profile : PROFILES) {
+         if (cache.get(profile)->probabilities() !=
+            AnalyticCombat::evaluate(profile).probabilities()) {
+            cout << "The cached distribution for " << profile.attacks
+               << " attacks differs from AnalyticCombat's." << endl;
+            failures++;
+         }
+      }
+   }
+   if (cache.misses() != 3 || cache.hits() != 3) {
+      cout << "Expected 3 misses and 3 hits, got " << cache.misses() << " and "
+         << cache.hits() << "." << endl;
+      failures++;
+   }
+
+   //Only small profiles, so solving them stays quick.
+   for (size_t i = 0, filled = 0; filled < 1000; i++) {
+      const CombatProfile& profile = profiles[i * 97 % profiles.size()];
+      if (profile.attacks > 40 || profile.damage > 6) continue;
+      cache.get(profile);
+      filled++;
+   }
+   if (cache.size() > 64 || cache.evictions() == 0) {
+      cout << "The cache holds " << cache.size() << " entries after "
+         << cache.evictions() << " evictions, for a capacity of 64." << endl;
+      failures++;
+   }
+
+   //Damage too large for the key is solved but never stored.
+   const CombatProfile HUGE = { 3, 0, 4, 0, 0x1000000, 4, 3, 0, 2 };
+   size_t held = cache.size();
+   long long missed = cache.misses();
+   for (int pass = 0; pass < 2; pass++) {
+      if (MatchupCache::cacheable(HUGE) || cache.get(HUGE)->probabilities() !=
+         AnalyticCombat::evaluate(HUGE).probabilities()) {
+         cout << "Damage of " << HUGE.damage << " was cached or solved wrongly." << endl;
+         failures++;
+      }
+   }
+   if (cache.size() != held || cache.misses() != missed + 2) {
+      cout << "Uncacheable lookups changed the cache or weren't counted as misses." << endl;
+      failures++;
+   }
+
+   //A profile AnalyticCombat can't hold isn't solved or counted.
+   const CombatProfile UNSOLVABLE = { 3, 1, 4, 0, 1 << 29, 4, 3, 0, 2 };
+   if (cache.get(UNSOLVABLE) != nullptr || cache.size() != held
+      || cache.misses() != missed + 2) {
+      cout << "A profile too large to evaluate was solved or counted." << endl;
+      failures++;
+   }
+
+   cout << ((failures == 0) ? "MatchupCache keys and lookups: passed" :
+      "MatchupCache keys and lookups: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+/** @TestMonteCarlo.cpp */
+
+/** Check program for MonteCarlo. Runs a spread of profiles in both
+sampling modes and checks that the sampled mean damage and kill
+probability each land inside a confidence interval around the exact
+values from AnalyticCombat, and that AnalyticCombat refuses profiles
+too large to hold rather than running out of memory. The interval is Z_SCORE standard errors
+wide on either side, so with forty comparisons a correct engine fails
+one by chance far less than once in a thousand runs; the seed is fixed
+besides, so a run that passes keeps passing. Built as its own
+executable, like the other programs in tests/.
+
+Exits with 0 if every estimate is inside its interval, 1 otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../MonteCarlo.h"
+#include "../AnalyticCombat.h"
+#include "../CombatProfile.h"
+#include "../CombatRules.h"
+#include "../DamageDistribution.h"
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+const long long TRIALS = 200000;
+const double Z_SCORE = 4.0;
+const uint64_t SEED = 42;
+
+/** Checks one estimate against its exact value.
+
+"what" names the estimate in the report.
+"estimate" is the sampled value.
+"exact" is the exact value.
+"variance" is the variance of one trial.
+
+Precondition: None.
+Postcondition: Returns whether the estimate is within Z_SCORE standard
+errors of the exact value, and reports it if not. */
+bool withinInterval(const char* what, double estimate, double exact, double variance)
+{
+   double halfWidth = Z_SCORE * sqrt(variance / TRIALS);
+   if (fabs(estimate - exact) <= halfWidth) return true;
+
+   cout << what << ": sampled " << estimate << ", exact " << exact
+      << ", allowed +/- " << halfWidth << endl;
+   return false;
+}
+
+int main()
+{
+   //{hitStat, attacks, strength, ap, damage, toughness, armorSave, invulnSave, defenderWounds}
+   const CombatProfile PROFILES[] = {
+      { 3, 1, 4, 0, 1, 4, 3, 0, 1 },
+      { 4, 3, 5, 1, 2, 4, 4, 0, 3 },
+      { 2, 6, 9, 3, 3, 6, 3, 5, 6 },
+      { 3, 10, 8, 2, 2, 6, 3, 5, 15 },
+      { 5, 20, 3, 0, 1, 7, 2, 4, 2 },
+      { 3, 40, 4, 1, 1, 4, 3, 0, 10 },
+      { 6, 4, 10, 4, 6, 5, 2, 0, 12 },
+      { 3, 60, 16, 5, 3, 3, 6, 6, 30 },
+      { 4, 2, 2, 0, 1, 8, 7, 0, 1 },
+      { 3, 12, 6, 1, 1, 12, 2, 3, 4 },
+   };
+   const SamplingMode MODES[] = { DIE_BY_DIE, BINOMIAL };
+
+   int failures = 0;
+
+   for (SamplingMode mode : MODES) {
+      for (const CombatProfile& profile : PROFILES) {
+         DamageDistribution exact = AnalyticCombat::evaluate(profile);
+         double kill = exact.killProbability(profile.defenderWounds);
+
+         MonteCarlo engine(SEED);
+         engine.setSamplingMode(mode);
+         SimulationResult result = engine.run(profile, TRIALS);
+
+         bool passed = withinInterval("Mean damage", result.mean, exact.mean(),
+            exact.variance());
+         passed = withinInterval("Kill probability", result.killProbability, kill,
+            kill * (1 - kill)) && passed;
+
+         if (!passed) {
+            cout << "   for " << profile.attacks << " attacks at D" << profile.damage
+               << ((mode == BINOMIAL) ? ", binomial sampling" : ", die by die") << endl;
+            failures++;
+         }
+      }
+   }
+
+   //One attack at huge damage, or a huge pool at none, is too large.
+   const CombatProfile TOO_LARGE[] = {
+      { 3, 1, 4, 0, 1 << 29, 4, 3, 0, 1 },
+      { 3, 1 << 21, 4, 0, 0, 4, 3, 0, 1 },
+   };
+   for (const CombatProfile& profile : TOO_LARGE) {
+      bool refused = !AnalyticCombat::canEvaluate(profile);
+      try {
+         AnalyticCombat::evaluate(profile);
+         refused = false;
+      }
+      catch (const length_error&) {
+      }
+      if (!refused) {
+         cout << profile.attacks << " attacks at D" << profile.damage
+            << " weren't refused." << endl;
+         failures++;
+      }
+   }
+
+   cout << ((failures == 0) ? "Monte Carlo against the exact results: passed" :
+      "Monte Carlo against the exact results: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}
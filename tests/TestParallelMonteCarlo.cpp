@@ -0,0 +1,154 @@
+/** @TestParallelMonteCarlo.cpp */
+
+/** Check program for ParallelMonteCarlo. Runs the same matchups on
+pools of 1, 2, 4 and 8 threads, with trial counts that don't divide
+evenly into chunks, and checks that every run did exactly the trials
+asked for and that its mean damage and kill probability land within
+Z_SCORE standard errors of the exact values from AnalyticCombat. Since
+each trial draws from its own stream, every run must also give exactly
+the same histogram as MonteCarlo running the trials one after another,
+in both sampling modes.
+
+Adaptive runs are checked the same way: for each metric they must reach
+the width asked for, take the same trials and give the same histogram
+on every thread count, and their interval must hold the exact value.
+Built as its own executable, like the other programs in tests/.
+
+Exits with 0 if every run matches, 1 otherwise.
+
+Michael Patrick
+10/17/26 */
+
+#include "../ParallelMonteCarlo.h"
+#include "../MonteCarlo.h"
+#include "../AnalyticCombat.h"
+#include "../CombatProfile.h"
+#include "../DamageDistribution.h"
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+const long long TRIALS = 100003;
+const double Z_SCORE = 4.0;
+const uint64_t SEED = 7;
+
+/** Checks one estimate against its exact value.
+
+"what" names the estimate in the report.
+"estimate" is the sampled value.
+"exact" is the exact value.
+"variance" is the variance of one trial.
+
+Precondition: None.
+Postcondition: Returns whether the estimate is within Z_SCORE standard
+errors of the exact value, and reports it if not. */
+bool withinInterval(const char* what, double estimate, double exact, double variance)
+{
+   double halfWidth = Z_SCORE * sqrt(variance / TRIALS);
+   if (fabs(estimate - exact) <= halfWidth) return true;
+
+   cout << what << ": sampled " << estimate << ", exact " << exact
+      << ", allowed +/- " << halfWidth << endl;
+   return false;
+}
+
+int main()
+{
+   //{hitStat, attacks, strength, ap, damage, toughness, armorSave, invulnSave, defenderWounds}
+   const CombatProfile PROFILES[] = {
+      { 3, 10, 8, 2, 2, 6, 3, 5, 6 },
+      { 4, 40, 4, 1, 1, 4, 3, 0, 10 },
+   };
+   const int THREADS[] = { 1, 2, 4, 8 };
+   const SamplingMode MODES[] = { DIE_BY_DIE, BINOMIAL };
+
+   int failures = 0;
+
+   for (SamplingMode mode : MODES) for (int threads : THREADS) {
+      ParallelMonteCarlo engine(threads);
+      engine.setSamplingMode(mode);
+
+      for (const CombatProfile& profile : PROFILES) {
+         DamageDistribution exact = AnalyticCombat::evaluate(profile);
+         double kill = exact.killProbability(profile.defenderWounds);
+         SimulationResult result = engine.run(profile, TRIALS, SEED);
+
+         bool passed = (result.histogram.trials() == TRIALS);
+         if (!passed) {
+            cout << "Ran " << result.histogram.trials() << " trials instead of "
+               << TRIALS << "." << endl;
+         }
+         MonteCarlo serial(SEED);
+         serial.setSamplingMode(mode);
+         if (result.histogram.counts() != serial.run(profile, TRIALS).histogram.counts()) {
+            cout << "The histogram differs from the one MonteCarlo gives." << endl;
+            passed = false;
+         }
+         passed = withinInterval("Mean damage", result.mean, exact.mean(),
+            exact.variance()) && passed;
+         passed = withinInterval("Kill probability", result.killProbability, kill,
+            kill * (1 - kill)) && passed;
+
+         if (!passed) {
+            cout << "   for " << profile.attacks << " attacks on " << threads
+               << " threads, " << ((mode == BINOMIAL) ? "binomial" : "die by die")
+               << " sampling" << endl;
+            failures++;
+         }
+      }
+   }
+
+   //Adaptive runs, to a 99.99% interval so the exact value is inside.
+   const PrecisionTarget TARGETS[] = {
+      { MEAN_DAMAGE, 0.05, Z_SCORE },
+      { KILL_PROBABILITY, 0.01, Z_SCORE },
+   };
+   for (const CombatProfile& profile : PROFILES) {
+      DamageDistribution exact = AnalyticCombat::evaluate(profile);
+
+      for (const PrecisionTarget& target : TARGETS) {
+         double truth = (target.metric == MEAN_DAMAGE) ? exact.mean() :
+            exact.killProbability(profile.defenderWounds);
+         const char* metric = (target.metric == MEAN_DAMAGE) ? "mean damage" :
+            "kill probability";
+
+         AdaptiveResult reference;
+         for (int threads : THREADS) {
+            ParallelMonteCarlo engine(threads);
+            AdaptiveResult result = engine.runToPrecision(profile, target, SEED);
+
+            bool passed = true;
+            if (!result.converged || result.upper - result.lower > target.width) {
+               cout << "The interval on " << metric << " only narrowed to "
+                  << result.upper - result.lower << "." << endl;
+               passed = false;
+            }
+            if (truth < result.lower || truth > result.upper) {
+               cout << "The interval on " << metric << " [" << result.lower << ", "
+                  << result.upper << "] misses the exact " << truth << "." << endl;
+               passed = false;
+            }
+            if (threads == THREADS[0]) {
+               reference = result;
+            }
+            else if (result.result.histogram.counts() != reference.result.histogram.counts()) {
+               cout << "The adaptive run on " << metric << " differs from the one on "
+                  << THREADS[0] << " thread." << endl;
+               passed = false;
+            }
+
+            if (!passed) {
+               cout << "   for " << profile.attacks << " attacks on " << threads
+                  << " threads" << endl;
+               failures++;
+            }
+         }
+      }
+   }
+
+   cout << ((failures == 0) ? "Parallel Monte Carlo on every thread count: passed" :
+      "Parallel Monte Carlo on every thread count: FAILED") << endl;
+   return (failures == 0) ? 0 : 1;
+}